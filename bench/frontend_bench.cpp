@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "ir/cfg.hpp"
+#include "ir/liveness.hpp"
+#include "ir/ssa.hpp"
+#include "ir/tac.hpp"
+#include "parser/rd_parser.hpp"
+
+#include "temp_file.hpp"
+
+// Parser and TAC generator benchmark.
+// usage: frontend-bench [statements] [iterations] [depth] [limit]
+// Generates one function with `statements` statements mixing declarations,
+// nested blocks, loops and conditionals, spread over `depth` nested blocks
+// that each shadow the same name, then reports the bytes allocated
+// while parsing it (tree plus token list), the bytes allocated during TAC
+// generation and still held once it is done, and the best parse, TAC
+// generation, control flow analysis, liveness and SSA round trip times
+// over `iterations` runs. Build with -DCMAKE_BUILD_TYPE=Release for numbers
+// that mean anything. Given a limit, the same statements are also timed
+// without the nesting, and the run fails if TAC generation at `depth`
+// levels takes more than `limit` times as long; name lookup that walks the
+// scopes does.
+
+static std::atomic<size_t> s_Allocated{ 0 }, s_Live{ 0 };
+
+// every block starts with its size, so that deletes know how much they free
+static constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    s_Allocated += size;
+    s_Live += size;
+    if (auto block = static_cast<char*>(std::malloc(size + HEADER_SIZE)))
+    {
+        *reinterpret_cast<size_t*>(block) = size;
+        return block + HEADER_SIZE;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr) return;
+    auto block = static_cast<char*>(pointer) - HEADER_SIZE;
+    s_Live -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+static std::string build_function(size_t statements, size_t depth)
+{
+    std::string source = "int main() {\n    int total = 0;\n";
+    size_t groups = (statements + 3) / 4, opened = 0;
+    for (size_t i = 0; i < statements; i += 4)
+    {
+        // open the next level once its share of the groups is reached
+        while (opened < depth && opened * groups <= i / 4 * depth)
+        {
+            source += "    { int level = total & 15; total += level;\n";
+            opened++;
+        }
+        auto name = "value_" + std::to_string(i);
+        source += "    int " + name + " = total * 3 + " + std::to_string(i % 97) + ";\n";
+        source += "    if (" + name + " > 10) { total = total + " + name + " % 7; } else total -= 1;\n";
+        source += "    while (" + name + " > 0) { " + name + " = " + name + " >> 1; }\n";
+        source += "    { int inner = " + name + " ^ total; total += inner & 255; }\n";
+    }
+    source += std::string(opened, '}') + "\n    return total & 255;\n}\n";
+    return source;
+}
+
+// best TAC generation time of the function in path over `iterations` runs
+static double best_tac_time(const std::filesystem::path& path, size_t iterations)
+{
+    double best = 0;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        RDParser parser{ std::make_unique<Lexer>() };
+        auto ast = parser.ParseFile(path.string());
+        TACGenerator generator{ parser.Interner() };
+        auto start = std::chrono::steady_clock::now();
+        generator.GenerateStatements(ast);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t statements = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t iterations = argc > 2 ? std::stoul(argv[2]) : 5;
+    size_t depth = argc > 3 ? std::stoul(argv[3]) : 0;
+    double limit = argc > 4 ? std::stod(argv[4]) : 0;
+
+    auto source = build_function(statements, depth);
+    auto path = create_temp_file("frontend_bench");
+    {
+        std::ofstream out{ path, std::ios::binary };
+        out << source;
+    }
+
+    double best_parse = 0, best_tac = 0, best_cfg = 0, best_liveness = 0, best_ssa = 0;
+    size_t parse_bytes = 0, tac_bytes = 0, tac_held = 0, blocks = 0, tracked = 0;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        RDParser parser{ std::make_unique<Lexer>() };
+        size_t before = s_Allocated;
+        auto start = std::chrono::steady_clock::now();
+        auto ast = parser.ParseFile(path.string());
+        std::chrono::duration<double> parse_time = std::chrono::steady_clock::now() - start;
+        parse_bytes = s_Allocated - before;
+
+        TACGenerator generator{ parser.Interner() };
+        before = s_Allocated;
+        size_t live = s_Live;
+        start = std::chrono::steady_clock::now();
+        generator.GenerateStatements(ast);
+        std::chrono::duration<double> tac_time = std::chrono::steady_clock::now() - start;
+        tac_bytes = s_Allocated - before;
+        tac_held = s_Live - live;
+
+        auto program = generator.TakeProgram();
+        start = std::chrono::steady_clock::now();
+        blocks = 0;
+        for (const auto& function : program.functions)
+            blocks += TAC::ControlFlowGraph(*function).Blocks().size();
+        std::chrono::duration<double> cfg_time = std::chrono::steady_clock::now() - start;
+
+        std::chrono::duration<double> liveness_time{ 0 };
+        tracked = 0;
+        for (const auto& function : program.functions)
+        {
+            TAC::ControlFlowGraph graph{ *function };
+            start = std::chrono::steady_clock::now();
+            tracked += TAC::Liveness(graph).Tracked();
+            liveness_time += std::chrono::steady_clock::now() - start;
+        }
+
+        start = std::chrono::steady_clock::now();
+        for (auto& function : program.functions)
+            TAC::SSAForm(*function).Lower();
+        std::chrono::duration<double> ssa_time = std::chrono::steady_clock::now() - start;
+        best_parse = i == 0 ? parse_time.count() : std::min(best_parse, parse_time.count());
+        best_tac = i == 0 ? tac_time.count() : std::min(best_tac, tac_time.count());
+        best_cfg = i == 0 ? cfg_time.count() : std::min(best_cfg, cfg_time.count());
+        best_liveness = i == 0 ? liveness_time.count() : std::min(best_liveness, liveness_time.count());
+        best_ssa = i == 0 ? ssa_time.count() : std::min(best_ssa, ssa_time.count());
+    }
+    std::filesystem::remove(path);
+
+    std::cerr << "input: " << statements << " statements, " << depth << " levels, " << source.size() / 1024 << " KiB\n";
+    std::cerr << "parse: " << best_parse * 1000 << " ms, " << parse_bytes / 1024 << " KiB allocated\n";
+    std::cerr << "tac: " << best_tac * 1000 << " ms, " << tac_bytes / 1024 << " KiB allocated, "
+              << tac_held / 1024 << " KiB held (best of " << iterations << ")\n";
+    std::cerr << "cfg: " << best_cfg * 1000 << " ms, " << blocks << " blocks\n";
+    std::cerr << "liveness: " << best_liveness * 1000 << " ms, " << tracked << " values live across blocks\n";
+    std::cerr << "ssa: " << best_ssa * 1000 << " ms to build and lower\n";
+
+    if (limit > 0)
+    {
+        auto flat = create_temp_file("frontend_bench_flat");
+        {
+            std::ofstream out{ flat, std::ios::binary };
+            out << build_function(statements, 0);
+        }
+        double best_flat = best_tac_time(flat, iterations);
+        std::filesystem::remove(flat);
+        double ratio = best_tac / best_flat;
+        std::cerr << "tac without nesting: " << best_flat * 1000 << " ms, " << ratio << "x at " << depth << " levels\n";
+        if (ratio > limit)
+        {
+            std::cerr << "error: TAC generation at " << depth << " levels exceeds " << limit << "x the time without nesting\n";
+            return EXIT_FAILURE;
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lexer/lexer.hpp"
+
+#include "temp_file.hpp"
+
+// Lexer throughput benchmark.
+// usage: lexer-bench [scale] [iterations] [examples dir]
+// Concatenates every .c file under the valid/ directories of examples/,
+// whose invalid programs may not even lex, and repeats the corpus `scale`
+// times into a temporary file, then reports the best MB/s of Lexer::LexFile
+// over `iterations` runs. Build with -DCMAKE_BUILD_TYPE=Release for numbers
+// that mean anything.
+
+static std::string build_corpus(const std::filesystem::path& dir, size_t scale)
+{
+    std::vector<std::filesystem::path> files; 
+    for (auto& entry : std::filesystem::recursive_directory_iterator(dir))
+        if (entry.is_regular_file() && entry.path().extension() == ".c" &&
+            entry.path().parent_path().filename() == "valid")
+            files.emplace_back(entry.path()); 
+    // directory iteration order is unspecified
+    std::sort(files.begin(), files.end()); 
+
+    std::string corpus; 
+    for (auto& file : files)
+    {
+        std::ifstream in{ file }; 
+        std::stringstream buffer; 
+        buffer << in.rdbuf(); 
+        corpus += buffer.str(); 
+        corpus += '\n'; 
+    }
+
+    std::string scaled; 
+    scaled.reserve(corpus.size() * scale); 
+    for (size_t i = 0; i < scale; i++)
+        scaled += corpus; 
+    return scaled; 
+}
+
+int main(int argc, char* argv[])
+{
+    size_t scale = argc > 1 ? std::stoul(argv[1]) : 2000; 
+    size_t iterations = argc > 2 ? std::stoul(argv[2]) : 5; 
+    std::filesystem::path dir = argc > 3 ? argv[3] : EXAMPLES_DIR; 
+
+    auto corpus = build_corpus(dir, scale); 
+    auto path = create_temp_file("lexer_bench_corpus"); 
+    {
+        std::ofstream out{ path, std::ios::binary }; 
+        out << corpus; 
+    }
+
+    double best = 0; 
+    size_t token_count = 0; 
+    for (size_t i = 0; i < iterations; i++)
+    {
+        Lexer lexer{}; 
+        auto start = std::chrono::steady_clock::now(); 
+        token_count = lexer.LexFile(path.string()).size(); 
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start; 
+        best = std::max(best, corpus.size() / elapsed.count() / (1024.0 * 1024.0)); 
+    }
+    std::filesystem::remove(path); 
+
+    std::cerr << "corpus: " << corpus.size() / (1024.0 * 1024.0) << " MB, " << token_count << " tokens\n"; 
+    std::cerr << "lexer: " << best << " MB/s (best of " << iterations << ")\n"; 
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lexer/lexer.hpp"
+
+#include "temp_file.hpp"
+
+// Check of the parallel lexer against the serial one.
+// usage: lexer-chunks
+// Generates an input past Lexer::PARALLEL_LEX_THRESHOLD that is mostly
+// block comments, so that chunk bounds land inside them and have to be
+// pushed past their end, with line comments that contain "/*" in
+// between. The input is lexed in chunks and in one piece, and the check
+// fails unless both give the same tokens, each on the line counted by
+// hand. The split is made for four threads whatever the machine has.
+
+// exposes the chunked and serial paths that LexFile picks between
+class ChunkLexer : public Lexer
+{
+    public:
+        using Lexer::LexChunks;
+        using Lexer::LexRange;
+        using Lexer::OpenSource;
+        using Lexer::SplitChunks;
+
+        std::string_view Source() const { return m_Source.view(); }
+};
+
+static std::string build_input()
+{
+    std::string source;
+    for (size_t i = 0; source.size() < Lexer::PARALLEL_LEX_THRESHOLD + (1 << 20); i++)
+    {
+        auto n = std::to_string(i);
+        source += "int f_" + n + "() {\n";
+        source += "    int a = " + n + "; // not a block comment: /* a = 0;\n";
+        source += "    return a + 0x1F; // */ a = 1;\n";
+        source += "}\n";
+        source += "/* comment " + n + " of lines that look like code\n";
+        for (size_t line = 0; line < 24; line++)
+            source += "   int hidden_" + n + " = " + std::to_string(line) + "; // /* ** * / { } ;\n";
+        source += "*/ int after_" + n + " = " + n + ";\n";
+    }
+    return source;
+}
+
+int main()
+{
+    auto path = create_temp_file("lexer_chunks");
+    {
+        std::ofstream out{ path, std::ios::binary };
+        out << build_input();
+    }
+
+    ChunkLexer lexer{};
+    if (!lexer.OpenSource(path.string())) return EXIT_FAILURE;
+    auto source = lexer.Source();
+    auto bounds = lexer.SplitChunks(source, 4);
+    // some bound has to have been moved out of a block comment
+    size_t moved = 0;
+    for (size_t i = 1; i + 1 < bounds.size(); i++)
+    {
+        if (source.substr(bounds[i] - 2, 2) == "*/") moved++;
+    }
+    auto chunked = lexer.LexChunks(source, bounds);
+    auto serial = lexer.LexRange(source, 0, source.length());
+    std::filesystem::remove(path);
+
+    int failures = 0;
+    auto fail = [&failures](const std::string& message) {
+        if (failures++ < 10) std::cerr << "lexer-chunks: " << message << "\n";
+    };
+    if (bounds.size() < 3) fail("the input was not split");
+    if (moved == 0) fail("no chunk bound fell inside a block comment");
+    if (chunked.size() != serial.size())
+        fail(std::to_string(chunked.size()) + " tokens in chunks, " + std::to_string(serial.size()) + " serially");
+    size_t line = 1, counted = 0;
+    for (size_t i = 0; i < std::min(chunked.size(), serial.size()); i++)
+    {
+        auto a = chunked[i], b = serial[i];
+        if (a.kind != b.kind || a.offset != b.offset || a.value != b.value || a.constant != b.constant)
+        {
+            fail("token " + std::to_string(i) + " differs at offset " + std::to_string(a.offset));
+            continue;
+        }
+        for (; counted < a.offset; counted++)
+        {
+            if (source[counted] == '\n') line++;
+        }
+        if (lexer.Locate(a.offset).line != line)
+            fail("token " + std::to_string(i) + " located on line " + std::to_string(lexer.Locate(a.offset).line) +
+                 ", expected " + std::to_string(line));
+    }
+
+    std::cerr << "lexer-chunks: " << source.size() / 1024 << " KiB, " << bounds.size() - 1 << " chunks, "
+              << moved << " bounds moved past comments, " << chunked.size() << " tokens\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
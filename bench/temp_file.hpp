@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+// Creates an empty file with a unique name in the temporary directory, so
+// that benchmarks run side by side never write over each other's input.
+// The name keeps a .c suffix.
+inline std::filesystem::path create_temp_file(const std::string& prefix)
+{
+    auto pattern = (std::filesystem::temp_directory_path() / (prefix + "-XXXXXX.c")).string(); 
+    int fd = mkstemps(pattern.data(), 2); 
+    if (fd < 0)
+        throw std::runtime_error("error: Could not create a temporary file from '" + pattern + "'"); 
+    close(fd); 
+    return pattern; 
+}
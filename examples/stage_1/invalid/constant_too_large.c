@@ -0,0 +1,3 @@
+int main() {
+    return 4294967296;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+// leading comment
+int main() /* inline */ {
+    /* multi
+       line */
+    return 2; // trailing comment
+}
@@ -0,0 +1,3 @@
+int main() {
+    return 0X2a;
+}
\ No newline at end of file
@@ -0,0 +1,3 @@
+int main() {
+    return 017;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+int main()
+{
+    int a = 12;
+    a &= 10;
+    a |= 5;
+    a ^= 3;
+    a <<= 2;
+    a >>= 1;
+    return a;
+}
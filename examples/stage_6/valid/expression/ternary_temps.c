@@ -0,0 +1,6 @@
+int main() {
+    int a = 3, b = 4, c = 0, d = 5, e = 6;
+    int x = a * b + (c ? d : e) * (a - b);
+    int y = (a + 1) * ((b && c) + (d || e)) - (x << 1);
+    return (x + y) & 255;
+}
@@ -0,0 +1,7 @@
+int main() {
+    int a = 1;
+    { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; { int b = a; 
+    a = ((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((b + 2))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))));
+    a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } a = a + b; } 
+    return a - -(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(-(1))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))));
+}
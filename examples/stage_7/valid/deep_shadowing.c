@@ -0,0 +1,406 @@
+int main() {
+    int s = 0;
+    int a = 1;
+    int b = 2;
+    { int a = b + 0; int b = a % 7 + 0;
+    { int a = b + 1; int b = a % 7 + 1;
+    { int a = b + 2; int b = a % 7 + 2;
+    { int a = b + 3; int b = a % 7 + 3;
+    { int a = b + 4; int b = a % 7 + 4;
+    { int a = b + 5; int b = a % 7 + 0;
+    { int a = b + 6; int b = a % 7 + 1;
+    { int a = b + 7; int b = a % 7 + 2;
+    { int a = b + 8; int b = a % 7 + 3;
+    { int a = b + 9; int b = a % 7 + 4;
+    { int a = b + 10; int b = a % 7 + 0;
+    { int a = b + 11; int b = a % 7 + 1;
+    { int a = b + 12; int b = a % 7 + 2;
+    { int a = b + 0; int b = a % 7 + 3;
+    { int a = b + 1; int b = a % 7 + 4;
+    { int a = b + 2; int b = a % 7 + 0;
+    { int a = b + 3; int b = a % 7 + 1;
+    { int a = b + 4; int b = a % 7 + 2;
+    { int a = b + 5; int b = a % 7 + 3;
+    { int a = b + 6; int b = a % 7 + 4;
+    { int a = b + 7; int b = a % 7 + 0;
+    { int a = b + 8; int b = a % 7 + 1;
+    { int a = b + 9; int b = a % 7 + 2;
+    { int a = b + 10; int b = a % 7 + 3;
+    { int a = b + 11; int b = a % 7 + 4;
+    { int a = b + 12; int b = a % 7 + 0;
+    { int a = b + 0; int b = a % 7 + 1;
+    { int a = b + 1; int b = a % 7 + 2;
+    { int a = b + 2; int b = a % 7 + 3;
+    { int a = b + 3; int b = a % 7 + 4;
+    { int a = b + 4; int b = a % 7 + 0;
+    { int a = b + 5; int b = a % 7 + 1;
+    { int a = b + 6; int b = a % 7 + 2;
+    { int a = b + 7; int b = a % 7 + 3;
+    { int a = b + 8; int b = a % 7 + 4;
+    { int a = b + 9; int b = a % 7 + 0;
+    { int a = b + 10; int b = a % 7 + 1;
+    { int a = b + 11; int b = a % 7 + 2;
+    { int a = b + 12; int b = a % 7 + 3;
+    { int a = b + 0; int b = a % 7 + 4;
+    { int a = b + 1; int b = a % 7 + 0;
+    { int a = b + 2; int b = a % 7 + 1;
+    { int a = b + 3; int b = a % 7 + 2;
+    { int a = b + 4; int b = a % 7 + 3;
+    { int a = b + 5; int b = a % 7 + 4;
+    { int a = b + 6; int b = a % 7 + 0;
+    { int a = b + 7; int b = a % 7 + 1;
+    { int a = b + 8; int b = a % 7 + 2;
+    { int a = b + 9; int b = a % 7 + 3;
+    { int a = b + 10; int b = a % 7 + 4;
+    { int a = b + 11; int b = a % 7 + 0;
+    { int a = b + 12; int b = a % 7 + 1;
+    { int a = b + 0; int b = a % 7 + 2;
+    { int a = b + 1; int b = a % 7 + 3;
+    { int a = b + 2; int b = a % 7 + 4;
+    { int a = b + 3; int b = a % 7 + 0;
+    { int a = b + 4; int b = a % 7 + 1;
+    { int a = b + 5; int b = a % 7 + 2;
+    { int a = b + 6; int b = a % 7 + 3;
+    { int a = b + 7; int b = a % 7 + 4;
+    { int a = b + 8; int b = a % 7 + 0;
+    { int a = b + 9; int b = a % 7 + 1;
+    { int a = b + 10; int b = a % 7 + 2;
+    { int a = b + 11; int b = a % 7 + 3;
+    { int a = b + 12; int b = a % 7 + 4;
+    { int a = b + 0; int b = a % 7 + 0;
+    { int a = b + 1; int b = a % 7 + 1;
+    { int a = b + 2; int b = a % 7 + 2;
+    { int a = b + 3; int b = a % 7 + 3;
+    { int a = b + 4; int b = a % 7 + 4;
+    { int a = b + 5; int b = a % 7 + 0;
+    { int a = b + 6; int b = a % 7 + 1;
+    { int a = b + 7; int b = a % 7 + 2;
+    { int a = b + 8; int b = a % 7 + 3;
+    { int a = b + 9; int b = a % 7 + 4;
+    { int a = b + 10; int b = a % 7 + 0;
+    { int a = b + 11; int b = a % 7 + 1;
+    { int a = b + 12; int b = a % 7 + 2;
+    { int a = b + 0; int b = a % 7 + 3;
+    { int a = b + 1; int b = a % 7 + 4;
+    { int a = b + 2; int b = a % 7 + 0;
+    { int a = b + 3; int b = a % 7 + 1;
+    { int a = b + 4; int b = a % 7 + 2;
+    { int a = b + 5; int b = a % 7 + 3;
+    { int a = b + 6; int b = a % 7 + 4;
+    { int a = b + 7; int b = a % 7 + 0;
+    { int a = b + 8; int b = a % 7 + 1;
+    { int a = b + 9; int b = a % 7 + 2;
+    { int a = b + 10; int b = a % 7 + 3;
+    { int a = b + 11; int b = a % 7 + 4;
+    { int a = b + 12; int b = a % 7 + 0;
+    { int a = b + 0; int b = a % 7 + 1;
+    { int a = b + 1; int b = a % 7 + 2;
+    { int a = b + 2; int b = a % 7 + 3;
+    { int a = b + 3; int b = a % 7 + 4;
+    { int a = b + 4; int b = a % 7 + 0;
+    { int a = b + 5; int b = a % 7 + 1;
+    { int a = b + 6; int b = a % 7 + 2;
+    { int a = b + 7; int b = a % 7 + 3;
+    { int a = b + 8; int b = a % 7 + 4;
+    { int a = b + 9; int b = a % 7 + 0;
+    { int a = b + 10; int b = a % 7 + 1;
+    { int a = b + 11; int b = a % 7 + 2;
+    { int a = b + 12; int b = a % 7 + 3;
+    { int a = b + 0; int b = a % 7 + 4;
+    { int a = b + 1; int b = a % 7 + 0;
+    { int a = b + 2; int b = a % 7 + 1;
+    { int a = b + 3; int b = a % 7 + 2;
+    { int a = b + 4; int b = a % 7 + 3;
+    { int a = b + 5; int b = a % 7 + 4;
+    { int a = b + 6; int b = a % 7 + 0;
+    { int a = b + 7; int b = a % 7 + 1;
+    { int a = b + 8; int b = a % 7 + 2;
+    { int a = b + 9; int b = a % 7 + 3;
+    { int a = b + 10; int b = a % 7 + 4;
+    { int a = b + 11; int b = a % 7 + 0;
+    { int a = b + 12; int b = a % 7 + 1;
+    { int a = b + 0; int b = a % 7 + 2;
+    { int a = b + 1; int b = a % 7 + 3;
+    { int a = b + 2; int b = a % 7 + 4;
+    { int a = b + 3; int b = a % 7 + 0;
+    { int a = b + 4; int b = a % 7 + 1;
+    { int a = b + 5; int b = a % 7 + 2;
+    { int a = b + 6; int b = a % 7 + 3;
+    { int a = b + 7; int b = a % 7 + 4;
+    { int a = b + 8; int b = a % 7 + 0;
+    { int a = b + 9; int b = a % 7 + 1;
+    { int a = b + 10; int b = a % 7 + 2;
+    { int a = b + 11; int b = a % 7 + 3;
+    { int a = b + 12; int b = a % 7 + 4;
+    { int a = b + 0; int b = a % 7 + 0;
+    { int a = b + 1; int b = a % 7 + 1;
+    { int a = b + 2; int b = a % 7 + 2;
+    { int a = b + 3; int b = a % 7 + 3;
+    { int a = b + 4; int b = a % 7 + 4;
+    { int a = b + 5; int b = a % 7 + 0;
+    { int a = b + 6; int b = a % 7 + 1;
+    { int a = b + 7; int b = a % 7 + 2;
+    { int a = b + 8; int b = a % 7 + 3;
+    { int a = b + 9; int b = a % 7 + 4;
+    { int a = b + 10; int b = a % 7 + 0;
+    { int a = b + 11; int b = a % 7 + 1;
+    { int a = b + 12; int b = a % 7 + 2;
+    { int a = b + 0; int b = a % 7 + 3;
+    { int a = b + 1; int b = a % 7 + 4;
+    { int a = b + 2; int b = a % 7 + 0;
+    { int a = b + 3; int b = a % 7 + 1;
+    { int a = b + 4; int b = a % 7 + 2;
+    { int a = b + 5; int b = a % 7 + 3;
+    { int a = b + 6; int b = a % 7 + 4;
+    { int a = b + 7; int b = a % 7 + 0;
+    { int a = b + 8; int b = a % 7 + 1;
+    { int a = b + 9; int b = a % 7 + 2;
+    { int a = b + 10; int b = a % 7 + 3;
+    { int a = b + 11; int b = a % 7 + 4;
+    { int a = b + 12; int b = a % 7 + 0;
+    { int a = b + 0; int b = a % 7 + 1;
+    { int a = b + 1; int b = a % 7 + 2;
+    { int a = b + 2; int b = a % 7 + 3;
+    { int a = b + 3; int b = a % 7 + 4;
+    { int a = b + 4; int b = a % 7 + 0;
+    { int a = b + 5; int b = a % 7 + 1;
+    { int a = b + 6; int b = a % 7 + 2;
+    { int a = b + 7; int b = a % 7 + 3;
+    { int a = b + 8; int b = a % 7 + 4;
+    { int a = b + 9; int b = a % 7 + 0;
+    { int a = b + 10; int b = a % 7 + 1;
+    { int a = b + 11; int b = a % 7 + 2;
+    { int a = b + 12; int b = a % 7 + 3;
+    { int a = b + 0; int b = a % 7 + 4;
+    { int a = b + 1; int b = a % 7 + 0;
+    { int a = b + 2; int b = a % 7 + 1;
+    { int a = b + 3; int b = a % 7 + 2;
+    { int a = b + 4; int b = a % 7 + 3;
+    { int a = b + 5; int b = a % 7 + 4;
+    { int a = b + 6; int b = a % 7 + 0;
+    { int a = b + 7; int b = a % 7 + 1;
+    { int a = b + 8; int b = a % 7 + 2;
+    { int a = b + 9; int b = a % 7 + 3;
+    { int a = b + 10; int b = a % 7 + 4;
+    { int a = b + 11; int b = a % 7 + 0;
+    { int a = b + 12; int b = a % 7 + 1;
+    { int a = b + 0; int b = a % 7 + 2;
+    { int a = b + 1; int b = a % 7 + 3;
+    { int a = b + 2; int b = a % 7 + 4;
+    { int a = b + 3; int b = a % 7 + 0;
+    { int a = b + 4; int b = a % 7 + 1;
+    { int a = b + 5; int b = a % 7 + 2;
+    { int a = b + 6; int b = a % 7 + 3;
+    { int a = b + 7; int b = a % 7 + 4;
+    { int a = b + 8; int b = a % 7 + 0;
+    { int a = b + 9; int b = a % 7 + 1;
+    { int a = b + 10; int b = a % 7 + 2;
+    { int a = b + 11; int b = a % 7 + 3;
+    { int a = b + 12; int b = a % 7 + 4;
+    { int a = b + 0; int b = a % 7 + 0;
+    { int a = b + 1; int b = a % 7 + 1;
+    { int a = b + 2; int b = a % 7 + 2;
+    { int a = b + 3; int b = a % 7 + 3;
+    { int a = b + 4; int b = a % 7 + 4;
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    s = (s * 3 + a * 4 + b) % 1009; }
+    s = (s * 3 + a * 3 + b) % 1009; }
+    s = (s * 3 + a * 2 + b) % 1009; }
+    s = (s * 3 + a * 1 + b) % 1009; }
+    return (s + a + b) & 255;
+}
@@ -0,0 +1,35 @@
+int main() {
+    int a = 3;
+    int b = a * 4;
+    {
+        int a = 1;
+        a = a + b;
+        b = a;
+    }
+    if (a == 3)
+        b += 2;
+    else
+        b = 0;
+    int flag = 0;
+    if (b > 100)
+        flag = 1;
+    else if (b > 10)
+        flag = 2;
+    int sum = 0;
+    for (int i = 0; i < 4; i++) {
+        sum += a;
+        a = a + 1;
+        if (sum > 8)
+            continue;
+        flag = flag + 1;
+    }
+    int n = 2147483647;
+    n += 1;
+    int wrapped = n < 0;
+    int negative = (1 << 31) < 0;
+    do {
+        b = b - 1;
+    } while (b > 10);
+    int pick = a > 5 ? 10 : 20;
+    return a + b + flag + sum + wrapped + negative * 7 + pick;
+}
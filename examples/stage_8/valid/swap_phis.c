@@ -0,0 +1,37 @@
+int main() {
+    int a = 1, b = 2, c = 3;
+    int i = 0, sum = 0;
+    // swapping and rotating through copies makes the loop phis read each
+    // other, so their copies form cycles
+    while (i < 7) {
+        int t = a;
+        a = b;
+        b = t;
+        if (i % 3 == 0) {
+            t = c;
+            c = b;
+            b = a;
+            a = t;
+        } else if (i % 3 == 1)
+            sum = sum + a;
+        else {
+            int u = c;
+            c = sum;
+            sum = u;
+        }
+        i++;
+    }
+    for (int j = 0; j < 4; j++) {
+        if (j == 2) continue;
+        int k = 0;
+        do {
+            int t = a;
+            a = c;
+            c = t;
+            k++;
+            if (k > 2 && a > c) break;
+        } while (k < 5);
+        sum = sum * 3 + a - c;
+    }
+    return (sum * 7 + a * 5 + b * 3 + c) & 255;
+}
@@ -9,15 +9,15 @@ no_ext() {
 }
 
 run_correct() {
-    gcc -w "$1"
-    ./a.out >/dev/null
+    gcc -w "$1" -o "$work_dir/a.out"
+    "$work_dir/a.out" >/dev/null
     echo $?
 }
 
 run_custom() {
     output=$(eval "$1 $2")
     echo "$output"
-    local no_ext=$(no_ext "$filename")
+    local no_ext=$(no_ext "$2")
     temp=$(eval "$no_ext")
     exit_code=$?
     rm "$no_ext" >/dev/null 2>&1
@@ -28,6 +28,11 @@ run_custom() {
 absolute_dir=$(dirname "$(realpath $0)")
 failed=false
 
+# every binary is built in a private directory so that test runs can go in
+# parallel; no dots in the name, no_ext cuts at the first one
+work_dir=$(mktemp -d "${TMPDIR:-/tmp}/examples-XXXXXX")
+trap 'rm -rf "$work_dir"' EXIT
+
 # test valid examples
 for filename in `find $absolute_dir -type f -name "*.c" -path "$absolute_dir/stage_$2/valid/*" -not -path "*/valid_multifile/*" 2>/dev/null`; do
     [ -f "$filename" ] || break;
@@ -35,9 +40,9 @@ for filename in `find $absolute_dir -type f -name "*.c" -path "$absolute_dir/sta
     formatted_filename=$(no_path "$no_ext")
     # run gcc
     exit_code=$(run_correct "$filename")
-    rm a.out >/dev/null 2>&1
-    # run custom compiler
-    compiler_output=$(run_custom $1 "${filename}")
+    # run custom compiler on a copy, it writes its output next to the source
+    cp "$filename" "$work_dir/"
+    compiler_output=$(run_custom "$1" "$work_dir/$formatted_filename.c")
     custom_exit_code=$?
     if [ "$exit_code" != "$custom_exit_code" ]; then
         echo ""
@@ -55,13 +60,14 @@ for filename in `find $absolute_dir -type f -name "*.c"  -path "$absolute_dir/st
     [ -f "$filename" ] || break;
     no_ext=$(no_ext "$filename")
     formatted_filename=$(no_path "$no_ext")
-    compiler_output=$(eval "$1 $filename")
-    if [ -f "$no_ext" ]; then
+    cp "$filename" "$work_dir/"
+    compiler_output=$(eval "$1 $work_dir/$formatted_filename.c")
+    if [ -f "$work_dir/$formatted_filename" ]; then
         echo ""
         echo "Test failed for $formatted_filename"
         echo "Compiler output: $compiler_output"
         echo ""
-        rm "$no_ext" >/dev/null 2>&1
+        rm "$work_dir/$formatted_filename" >/dev/null 2>&1
         failed=true
     fi
 done
@@ -4,6 +4,7 @@ Compiler::Compiler(int argc, char* argv[])
 {
     ScanFlags(argc, argv); 
     m_Parser = std::make_unique<RDParser>(std::make_unique<Lexer>());
+    if (m_Flags.max_depth != 0) m_Parser->SetMaxDepth(m_Flags.max_depth); 
     m_CompilerBackend = std::make_unique<CompilerBackend>(); 
 }
 
@@ -12,6 +13,7 @@ Compiler::Compiler(const std::string& filepath, int argc, char* argv[])
     m_Flags.filepath = filepath; 
     ScanFlags(argc, argv);
     m_Parser = std::make_unique<RDParser>(std::make_unique<Lexer>());
+    if (m_Flags.max_depth != 0) m_Parser->SetMaxDepth(m_Flags.max_depth); 
     m_CompilerBackend = std::make_unique<CompilerBackend>(); 
 }
 
@@ -36,31 +38,84 @@ void Compiler::CompileProgram()
             LogError("Failed to generate abstract syntax tree."); 
             return;
         }
-        // constant folding
-        //OptimizeTree(ast);
-        m_Parser->LogTree(std::cout, ast); 
-        m_CompilerBackend->GenerateCode(m_Flags, ast); 
+        if (m_Flags.optimize >= 1)
+            ConstantFolder(m_Parser->NodeArena(), m_Parser->Interner()).FoldProgram(ast); 
+        if (LOG_ENABLED(Parser, Info))
+            m_Parser->LogTree(Log::Stream(LogLevel::Info), ast); 
+        m_CompilerBackend->GenerateCode(m_Flags, ast, m_Parser->Interner()); 
     } catch (const std::exception& exc)
     {
-        std::cout << exc.what() << std::endl;
+        std::cerr << exc.what() << std::endl;
     }
 }
 
 void Compiler::ScanFlags(int argc, char* argv[])
 {
-    if (argc > 1)
-        m_Flags.filepath = argv[1]; 
+    // the first argument that is not a flag is the source file
+    bool has_filepath = false; 
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i]; 
+        if (arg == "-s" || arg == "-S")
+            m_Flags.output_asm = true;
+        else if (arg.substr(0, 6) == "-emit=")
+            ScanEmitFlag(arg.substr(6)); 
+        else if (arg.substr(0, 11) == "-max-depth=")
+            ScanMaxDepthFlag(arg.substr(11)); 
+        else if (arg.substr(0, 2) == "-O")
+            ScanOptimizeFlag(arg.substr(2)); 
+        else if (arg.length() > 1 && arg[0] == '-')
+            LogWarn(("Unknown flag '" + std::string(arg) + "'").c_str()); 
+        else if (!has_filepath)
+        {
+            m_Flags.filepath = arg; 
+            has_filepath = true; 
+        }
+    }
 
     auto& filepath = m_Flags.filepath; 
-    if (!filepath.empty() && filepath.substr(filepath.length() - 2) == ".c")
+    if (filepath.length() > 2 && filepath.substr(filepath.length() - 2) == ".c")
         m_Flags.outputpath = filepath.substr(0, filepath.length() - 2); 
+}
 
-    for (int i = 0; i < argc; i++)
+void Compiler::ScanEmitFlag(std::string_view categories)
+{
+    // -emit=ast,tac prints the listed stages' output to stdout
+    while (!categories.empty())
     {
-        const char* arg = argv[i]; 
-        if (memcmp(arg, "-s", 2) == 0 || memcmp(arg, "-S", 2) == 0)
-            m_Flags.output_asm = true;
+        auto comma = categories.find(','); 
+        auto name = categories.substr(0, comma); 
+        LogCategory category; 
+        if (Log::FindCategory(name, category))
+            Log::SetLevel(category, LogLevel::Info); 
+        else LogWarn(("Unknown -emit category '" + std::string(name) + "'").c_str()); 
+        categories = comma == std::string_view::npos ? std::string_view() : categories.substr(comma + 1); 
+    }
+}
+
+void Compiler::ScanMaxDepthFlag(std::string_view value)
+{
+    // -max-depth=N bounds how deeply statements and expressions may nest
+    size_t depth = 0; 
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), depth); 
+    if (error != std::errc() || end != value.data() + value.size() || depth == 0)
+        LogWarn(("Invalid -max-depth value '" + std::string(value) + "'").c_str()); 
+    else m_Flags.max_depth = depth; 
+}
+
+void Compiler::ScanOptimizeFlag(std::string_view level)
+{
+    // -O is -O1; there is nothing past -O1 yet, higher levels are clamped
+    if (level.empty())
+    {
+        m_Flags.optimize = 1; 
+        return; 
     }
+    int value = 0; 
+    auto [end, error] = std::from_chars(level.data(), level.data() + level.size(), value); 
+    if (error != std::errc() || end != level.data() + level.size() || value < 0)
+        LogWarn(("Invalid optimization level '-O" + std::string(level) + "'").c_str()); 
+    else m_Flags.optimize = value > 1 ? 1 : value; 
 }
 
 void Compiler::LogWarn(const char* msg)
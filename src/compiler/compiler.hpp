@@ -1,10 +1,13 @@
 #pragma once
 
 #include <assert.h>
+#include <charconv>
 #include <cstring>
 #include <memory>
+#include <string_view>
 
 #include "flags.hpp"
+#include "log.hpp"
 #include "gen/backend.hpp"
 #include "gen/code_gen.hpp"
 #include "gen/opt/constant_opt.hpp"
@@ -28,6 +31,9 @@ class Compiler
         std::unique_ptr<CompilerBackend> m_CompilerBackend; 
         
         void ScanFlags(int argc, char* argv[]); 
+        void ScanEmitFlag(std::string_view categories); 
+        void ScanMaxDepthFlag(std::string_view value); 
+        void ScanOptimizeFlag(std::string_view level); 
         void LogWarn(const char* msg); 
         void LogError(const char* msg); 
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 struct CompilerFlags
@@ -7,4 +8,8 @@ struct CompilerFlags
     std::string filepath;
     std::string outputpath = "a.out"; 
     bool output_asm = false; 
+    // deepest statement/expression nesting the parser accepts, 0 keeps its default
+    size_t max_depth = 0; 
+    // -O level, 1 and up enable the tree optimizations
+    int optimize = 0; 
 };
\ No newline at end of file
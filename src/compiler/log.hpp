@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+// Leveled logging split by compiler stage. LOG(Category, Level) << ... costs
+// a single branch when that category is quieter than the level, and the
+// branch folds away entirely for levels above LOG_MAX_LEVEL. Errors and
+// warnings go to stderr; Info is used for the dumps requested with -emit
+// and goes to stdout.
+
+enum class LogCategory : uint8_t
+{
+    Lexer,
+    Parser,
+    TAC,
+    CFG,
+    SSA,
+    ASM,
+    Count
+};
+
+enum class LogLevel : uint8_t
+{
+    Off,
+    Error,
+    Warn,
+    Info,
+    Debug
+};
+
+#ifndef LOG_MAX_LEVEL
+#define LOG_MAX_LEVEL LogLevel::Debug
+#endif
+
+class Log
+{
+    public:
+        static bool Enabled(LogCategory category, LogLevel level)
+        {
+            return level <= LOG_MAX_LEVEL && level <= s_Levels[static_cast<size_t>(category)]; 
+        }
+
+        static void SetLevel(LogCategory category, LogLevel level)
+        {
+            s_Levels[static_cast<size_t>(category)] = level; 
+        }
+
+        static std::ostream& Stream(LogLevel level)
+        {
+            return level <= LogLevel::Warn ? std::cerr : std::cout; 
+        }
+
+        // names accepted by -emit: "tokens" dumps the lexed tokens, "ast"
+        // the parsed tree, "tac" the three-address code, "cfg" its control
+        // flow graphs, "ssa" its SSA form (built at -O1 only) and "asm" the
+        // generated assembly
+        static bool FindCategory(std::string_view name, LogCategory& category)
+        {
+            if (name == "tokens" || name == "lexer") category = LogCategory::Lexer; 
+            else if (name == "ast" || name == "parser") category = LogCategory::Parser; 
+            else if (name == "tac") category = LogCategory::TAC; 
+            else if (name == "cfg") category = LogCategory::CFG; 
+            else if (name == "ssa") category = LogCategory::SSA; 
+            else if (name == "asm") category = LogCategory::ASM; 
+            else return false; 
+            return true; 
+        }
+
+    private:
+        static_assert(static_cast<size_t>(LogCategory::Count) == 6, "every category needs a default level"); 
+        static inline std::array<LogLevel, static_cast<size_t>(LogCategory::Count)> s_Levels
+        {
+            LogLevel::Warn, LogLevel::Warn, LogLevel::Warn, LogLevel::Warn, LogLevel::Warn, LogLevel::Warn
+        };
+};
+
+#define LOG_ENABLED(category, level) Log::Enabled(LogCategory::category, LogLevel::level)
+#define LOG(category, level) if (!LOG_ENABLED(category, level)) {} else Log::Stream(LogLevel::level)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cassert>
 #include <memory>
 
 #include "register.hpp"
@@ -30,10 +31,19 @@ public:
 
     typedef std::shared_ptr<AssemblyArg> Ref; 
     
+    // checked downcasts keyed on the argument's tag
     template<typename T>
-    static std::shared_ptr<T> RefCast(AssemblyArg::Ref ref)
+    static T* RefCast(const AssemblyArg::Ref& ref)
     {
-        return std::dynamic_pointer_cast<T>(ref); 
+        assert(ref == nullptr || ref->type() == T::TYPE); 
+        return static_cast<T*>(ref.get()); 
+    }
+
+    template<typename T>
+    static const T& Cast(const AssemblyArg& arg)
+    {
+        assert(arg.type() == T::TYPE); 
+        return static_cast<const T&>(arg); 
     }
 
 private:
@@ -57,6 +67,7 @@ public:
     }
 
     typedef std::shared_ptr<RegisterArg> Ref; 
+    static constexpr ArgType TYPE = ArgType::Register;
 
 protected:
     RegisterArg(ArgType type, Register _register) : AssemblyArg(type), _register(_register)
@@ -78,6 +89,7 @@ struct PointerArg : public RegisterArg
     }
 
     typedef std::shared_ptr<PointerArg> Ref; 
+    static constexpr ArgType TYPE = ArgType::Pointer;
 };
 
 struct ImmediateArg : public AssemblyArg
@@ -87,6 +99,8 @@ struct ImmediateArg : public AssemblyArg
     }
 
     int value;
+
+    static constexpr ArgType TYPE = ArgType::Immediate;
 };
 
 struct LabelArg : public AssemblyArg
@@ -96,4 +110,6 @@ struct LabelArg : public AssemblyArg
     }
 
     std::string label;
+
+    static constexpr ArgType TYPE = ArgType::Label;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "arg.hpp"
+#include "compiler/log.hpp"
 #include "gen/code_gen.hpp"
 #include "instruction.hpp"
 
@@ -28,7 +29,7 @@ class ASMCodeGenerator : public CodeGenerator
             switch (dst.type())
             {
                 case ArgType::Register:
-                    return std::make_optional<OperandSize>(RegisterUtility::get_register_size(dynamic_cast<const RegisterArg&>(dst)._register));
+                    return std::make_optional<OperandSize>(RegisterUtility::get_register_size(AssemblyArg::Cast<RegisterArg>(dst)._register));
             }                
             return std::nullopt;
         }
@@ -80,7 +81,7 @@ class ASMCodeGenerator : public CodeGenerator
             if (InstructionUtility::needs_operand_size(op))
             {
                 if (inferredSize) opString = FormatInstruction(op, inferredSize.value()); 
-                else std::cout << "warning: Could not infer size for '" + opString +  "'\n";
+                else LOG(ASM, Warn) << "warning: Could not infer size for '" + opString +  "'\n";
             }
             outputstream() << m_IndentStr << opString << " " << EvaluateArg(dst) << "\n"; 
         }
@@ -106,14 +107,14 @@ class ASMCodeGenerator : public CodeGenerator
                 auto dst_size = InferSize(op, dst);
                 if (!src_size || !dst_size)
                 {
-                    std::cerr << "error: Expected register args for instruction 'movz'\n";
+                    LOG(ASM, Error) << "error: Expected register args for instruction 'movz'\n";
                     return;
                 }
                 opString += OperandUtility::to_string(src_size.value()) + OperandUtility::to_string(dst_size.value());
             } else if (InstructionUtility::needs_operand_size(op))
             {
                 if (inferredSize) opString = FormatInstruction(op, inferredSize.value()); 
-                else std::cout << "warning: Could not infer size for '" + opString +  "'\n";
+                else LOG(ASM, Warn) << "warning: Could not infer size for '" + opString +  "'\n";
             }
             outputstream() << m_IndentStr << opString << " " << EvaluateArg(src) << ", " << EvaluateArg(dst) << "\n"; 
         } 
@@ -152,10 +153,10 @@ class ASMCodeGenerator : public CodeGenerator
         {
             switch (arg.type())
             {
-                case ArgType::Register:   return EvaluateArg(dynamic_cast<const RegisterArg&&>(arg));
-                case ArgType::Pointer:    return EvaluateArg(dynamic_cast<const PointerArg&&>(arg));
-                case ArgType::Immediate:  return EvaluateArg(dynamic_cast<const ImmediateArg&&>(arg));
-                case ArgType::Label:      return EvaluateArg(dynamic_cast<const LabelArg&&>(arg));
+                case ArgType::Register:   return EvaluateArg(AssemblyArg::Cast<RegisterArg>(arg));
+                case ArgType::Pointer:    return EvaluateArg(AssemblyArg::Cast<PointerArg>(arg));
+                case ArgType::Immediate:  return EvaluateArg(AssemblyArg::Cast<ImmediateArg>(arg));
+                case ArgType::Label:      return EvaluateArg(AssemblyArg::Cast<LabelArg>(arg));
             }
             return std::string(); 
         }
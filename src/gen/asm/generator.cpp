@@ -1,50 +1,39 @@
 #include "generator.hpp"
 
-void ASMGenerator::GenerateAssembly(TACGenerator& generator)
+#include <algorithm>
+
+void ASMGenerator::GenerateAssembly(const TAC::Program& program, const StringInterner& names)
 {
-    auto var_context = generator.GetVarContext(); 
-    for (auto function : generator.GetFunctions())
+    for (const auto& function : program.functions)
     {
-        GenerateFunction(var_context, function);
+        GenerateFunction(*function, names);
     }
 }
 
-void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref function)
+void ASMGenerator::GenerateFunction(const TAC::Function& function, const StringInterner& names)
 {
-    auto statements = function->statements; 
-    m_CodeGenerator.EmitFun(function->function_name); 
+    const auto& statements = function.statements; 
+    m_Function = &function; 
+    m_Variables.assign(function.variables.size(), VarLocation()); 
+    m_Temps.assign(function.temp_count, VarLocation()); 
+    ComputeTempRanges(function); 
+    m_CodeGenerator.EmitFun(std::string(names.Lookup(function.function_name))); 
     m_CodeGenerator.IncreaseIndentation(); 
-    // calculate stack size
-    for (auto statement : statements)
-    {
-        VarSymbol::Ref symbol;
-        switch (statement->type())
-        {
-            case TAC::StatementType::Assign:
-            {
-                auto assign = TAC::Statement::RefCast<TAC::AssignStatement>(statement);
-                symbol = assign->lhs; 
-                break;
-            }
-            case TAC::StatementType::Triple:
-            {
-                auto triple = TAC::Statement::RefCast<TAC::TripleStatement>(statement);
-                symbol = triple->dst;
-                break;
-            }
-            case TAC::StatementType::Quad:
-            {
-                auto quad = TAC::Statement::RefCast<TAC::QuadStatement>(statement);
-                symbol = quad->dst; 
-                break;
-            }
-        }
-        if (symbol != nullptr && !symbol->is_temp && m_LocationTable.find(symbol) == m_LocationTable.end())
+    // calculate stack size; variables that are only read, before any
+    // assignment, still need a slot
+    auto place = [&](TAC::Operand operand) {
+        if (operand.type != TAC::OperandType::Variable) return; 
+        auto& loc = m_Variables[operand.id()]; 
+        if (loc.type() == VarLocation::Type::None)
         {
-            m_StackIndex -= symbol->byte_size;
-            auto loc = VarLocation(m_StackIndex); 
-            m_LocationTable[symbol] = loc;
+            m_StackIndex -= function.variables[operand.id()].byte_size;
+            loc = VarLocation(m_StackIndex); 
         }
+    }; 
+    for (const auto& statement : statements)
+    {
+        if (TAC::assigns_value(statement)) place(statement.dst); 
+        TAC::for_each_use(statement, place); 
     }
     // align stack size to multiple of 16
     auto stack_size = std::abs(m_StackIndex); 
@@ -53,23 +42,23 @@ void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref
     m_CodeGenerator.EmitOp(OpInstruction::PUSH, RegisterArg(Register::RBP));
     m_CodeGenerator.EmitOp(OpInstruction::MOV, RegisterArg(Register::RSP), RegisterArg(Register::RBP)); 
     if (stack_size > 0) m_CodeGenerator.EmitOp(OpInstruction::SUB, ImmediateArg(stack_size), RegisterArg(Register::RSP)); 
-    const std::string ret_label = "L" + std::to_string(function->label_counter + 1); 
+    const std::string ret_label = TAC::label_name(static_cast<uint32_t>(function.label_positions.size())); 
     bool emit_ret_label = false, found_ret = false;
+    size_t next_start = 0, next_end = 0; 
     for (size_t i = 0; i < statements.size(); i++)
     {
-        auto statement = statements[i]; 
-        switch (statement->type())
+        const auto& statement = statements[i]; 
+        // temps hold a register from the start of their range to its end
+        for (; next_start < m_TempsByStart.size() && m_Ranges[m_TempsByStart[next_start]].start == i; next_start++)
+            m_Temps[m_TempsByStart[next_start]] = VarLocation(allocator.AllocRegister()); 
+        switch (statement.type)
         {
             case TAC::StatementType::Goto:
-            {
-                auto _goto = TAC::Statement::RefCast<TAC::GotoStatement>(statement); 
-                m_CodeGenerator.EmitOp(OpInstruction::JMP, LabelArg(_goto->label));
+                m_CodeGenerator.EmitOp(OpInstruction::JMP, FetchLabel(statement.dst));
                 break;
-            }
             case TAC::StatementType::Condition:
             {
-                auto cond_statement = TAC::Statement::RefCast<TAC::ConditionStatement>(statement);
-                auto loc = FetchVarLocation(cond_statement->condition); 
+                auto loc = FetchVarLocation(statement.lhs); 
                 if (loc->type() == ArgType::Immediate)
                 {
                     auto _reg = allocator.AllocRegister(); 
@@ -77,16 +66,14 @@ void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref
                     loc = CreateRef<RegisterArg>(_reg); 
                     allocator.FreeRegister(_reg); 
                 }
-                m_CodeGenerator.EmitOp<OperandSize::DWORD>(OpInstruction::CMP, ImmediateArg(cond_statement->value), *loc.get()); 
-                m_CodeGenerator.EmitOp(OpInstruction::JNE, LabelArg(cond_statement->goto_label)); 
+                m_CodeGenerator.EmitOp<OperandSize::DWORD>(OpInstruction::CMP, ImmediateArg(statement.rhs.value), *loc.get()); 
+                m_CodeGenerator.EmitOp(OpInstruction::JNE, FetchLabel(statement.dst)); 
                 break;
             }
             case TAC::StatementType::Assign:
             {
-                auto assign = TAC::Statement::RefCast<TAC::AssignStatement>(statement);
-                auto src = FetchVarLocation(assign->rhs); 
-                AllocIfTemp(var_context, assign->lhs);
-                auto dst = FetchVarLocation(var_context, assign->lhs); 
+                auto src = FetchVarLocation(statement.rhs); 
+                auto dst = FetchVarLocation(statement.dst); 
                 if (IsPointer(src) && IsPointer(dst))
                 {
                     auto _reg = allocator.AllocRegister();
@@ -98,28 +85,17 @@ void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref
                 break;
             }
             case TAC::StatementType::Triple:
-            {
-                auto triple = TAC::Statement::RefCast<TAC::TripleStatement>(statement);
-                GenerateTriple(var_context, triple); 
+                GenerateTriple(statement); 
                 break;
-            }
             case TAC::StatementType::Quad:
-            {
-                auto quad = TAC::Statement::RefCast<TAC::QuadStatement>(statement);
-                GenerateQuad(var_context, quad);
+                GenerateQuad(statement);
                 break;
-            }
             case TAC::StatementType::Label:
-            {
-                auto label = TAC::Statement::RefCast<TAC::LabelStatement>(statement); 
-                m_CodeGenerator.EmitLabel(LabelArg(label->name));
+                m_CodeGenerator.EmitLabel(FetchLabel(statement.dst));
                 break;
-            }
             case TAC::StatementType::Return:
             {
-                auto return_statement = TAC::Statement::RefCast<TAC::ReturnStatement>(statement); 
-                auto ret_val = return_statement->ret_val;
-                auto src = FetchVarLocation(ret_val); 
+                auto src = FetchVarLocation(statement.rhs); 
                     if (!IsRegister(src, Register::EAX))
                         m_CodeGenerator.EmitOp(OpInstruction::MOV, src, RegisterArg(Register::EAX)); 
                 if (i == statements.size() - 1)
@@ -133,12 +109,8 @@ void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref
             }
         }
         // free temp registers
-        for (auto pair : m_LocationTable)
-        {
-            auto symbol = pair.first;
-            if (symbol->is_temp && symbol->range.end == i)
-                allocator.FreeRegister(m_LocationTable[symbol]._register);
-        }
+        for (; next_end < m_TempsByEnd.size() && m_Ranges[m_TempsByEnd[next_end]].end == i; next_end++)
+            allocator.FreeRegister(m_Temps[m_TempsByEnd[next_end]]._register); 
     }
     end:
     // move zero into EAX if there is no ret
@@ -153,12 +125,29 @@ void ASMGenerator::GenerateFunction(VarContext& var_context, TAC::Function::Ref
     m_CodeGenerator.DecreaseIndentation();
 }
 
-void ASMGenerator::GenerateTriple(VarContext& var_context, TAC::TripleStatement::Ref triple)
+void ASMGenerator::ComputeTempRanges(const TAC::Function& function)
+{
+    // liveness stretches the ranges over the loops temps are live around
+    TAC::ControlFlowGraph graph{ function }; 
+    m_Ranges = TAC::Liveness(graph).TempRanges(); 
+    m_TempsByStart.clear(); 
+    for (uint32_t temp = 0; temp < m_Ranges.size(); temp++)
+    {
+        if (!m_Ranges[temp].empty()) m_TempsByStart.push_back(temp); 
+    }
+    m_TempsByEnd = m_TempsByStart; 
+    std::stable_sort(m_TempsByStart.begin(), m_TempsByStart.end(),
+        [this](uint32_t a, uint32_t b) { return m_Ranges[a].start < m_Ranges[b].start; }); 
+    std::stable_sort(m_TempsByEnd.begin(), m_TempsByEnd.end(),
+        [this](uint32_t a, uint32_t b) { return m_Ranges[a].end < m_Ranges[b].end; }); 
+}
+
+void ASMGenerator::GenerateTriple(const TAC::Statement& triple)
 {
-    auto op = triple->op; 
-    AllocIfTemp(var_context, triple->dst);
-    auto src = FetchVarLocation(triple->rhs); 
-    auto dst_loc = FetchVarLocation(var_context, triple->dst); 
+    auto op = triple.op; 
+    auto src = FetchVarLocation(triple.rhs); 
+    auto dst_loc = FetchVarLocation(triple.dst); 
+    LoadIfBothPointers(src, dst_loc); 
     switch (op)
     {
         case TAC::OpCode::NEG:
@@ -185,13 +174,12 @@ void ASMGenerator::GenerateTriple(VarContext& var_context, TAC::TripleStatement:
     }
 }
 
-void ASMGenerator::GenerateQuad(VarContext& var_context, TAC::QuadStatement::Ref quad)
+void ASMGenerator::GenerateQuad(const TAC::Statement& quad)
 {
-    auto op = quad->op; 
-    AllocIfTemp(var_context, quad->dst);
-    auto lhs_loc = FetchVarLocation(quad->lhs);
-    auto rhs_loc = FetchVarLocation(quad->rhs); 
-    auto dst_loc = FetchVarLocation(var_context, quad->dst); 
+    auto op = quad.op; 
+    auto lhs_loc = FetchVarLocation(quad.lhs);
+    auto rhs_loc = FetchVarLocation(quad.rhs); 
+    auto dst_loc = FetchVarLocation(quad.dst); 
     switch (op)
     {
         case TAC::OpCode::ADD:
@@ -220,6 +208,7 @@ void ASMGenerator::GenerateQuad(VarContext& var_context, TAC::QuadStatement::Ref
                 case TAC::OpCode::RSH:
                     instruction = OpInstruction::SAR; break;
             }
+            LoadIfBothPointers(lhs_loc, dst_loc); 
             if (!IsSameRegister(lhs_loc, dst_loc))
                 m_CodeGenerator.EmitOp<OperandSize::DWORD>(OpInstruction::MOV, *lhs_loc.get(), *dst_loc.get()); 
             if (IsPointer(rhs_loc) && IsPointer(dst_loc))
@@ -2,7 +2,7 @@
 
 #include <stack>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "arg.hpp"
 #include "code_gen.hpp"
@@ -10,13 +10,13 @@
 #include "register.hpp"
 #include "reg_alloc.hpp"
 
-#include "gen/context.hpp"
+#include "ir/liveness.hpp"
 #include "ir/tac.hpp"
 
 class VarLocation
 {
 public:
-    int stack_offset; 
+    int stack_offset = 0; 
     Register _register;
 
     enum class Type
@@ -49,24 +49,34 @@ public:
     {
     }
 
-    void GenerateAssembly(TACGenerator& generator);
-    void GenerateFunction(VarContext& var_context, TAC::Function::Ref function);
-    void GenerateTriple(VarContext& var_context, TAC::TripleStatement::Ref triple);
-    void GenerateQuad(VarContext& var_context, TAC::QuadStatement::Ref quad); 
+    void GenerateAssembly(const TAC::Program& program, const StringInterner& names);
+    void GenerateFunction(const TAC::Function& function, const StringInterner& names);
+    void GenerateTriple(const TAC::Statement& triple);
+    void GenerateQuad(const TAC::Statement& quad); 
 
 private: 
     ASMCodeGenerator& m_CodeGenerator; 
     RegisterAllocator allocator{}; 
     int m_StackIndex = 0; 
 
-    std::unordered_map<VarSymbol::Ref, VarLocation> m_LocationTable;
-
-    void AllocIfTemp(VarContext& var_context, VarSymbol::Ref var_symbol)
+    // the function being generated and where its variables and temps live,
+    // indexed like its operand tables
+    const TAC::Function* m_Function = nullptr; 
+    std::vector<VarLocation> m_Variables; 
+    std::vector<VarLocation> m_Temps; 
+    // statements during which each temp holds its register, and the temps
+    // in the order their ranges start and end
+    std::vector<TAC::Liveness::Range> m_Ranges; 
+    std::vector<uint32_t> m_TempsByStart; 
+    std::vector<uint32_t> m_TempsByEnd; 
+
+    VarLocation& GetLocation(TAC::Operand operand)
     {
-        if (var_symbol->is_temp && m_LocationTable.find(var_symbol) == m_LocationTable.end()) 
-            m_LocationTable[var_symbol] = VarLocation(allocator.AllocRegister()); 
+        return operand.type == TAC::OperandType::Temp ? m_Temps[operand.id()] : m_Variables[operand.id()]; 
     }
 
+    void ComputeTempRanges(const TAC::Function& function); 
+
     inline bool IsRegister(AssemblyArg::Ref arg, Register _register)
     {
         return arg->type() == ArgType::Register && AssemblyArg::RefCast<RegisterArg>(arg)->_register == _register; 
@@ -107,22 +117,31 @@ private:
         return arg->type() == ArgType::Pointer; 
     }
 
-    AssemblyArg::Ref FetchVarLocation(VarContext& var_context, VarSymbol::Ref var_symbol)
+    // x86 has no memory to memory moves, so a source in memory that is
+    // moved to a destination in memory goes through a register first
+    void LoadIfBothPointers(AssemblyArg::Ref& src, AssemblyArg::Ref dst)
     {
-        auto loc = m_LocationTable[var_symbol];
-        if (var_symbol->is_temp) return CreateRef<RegisterArg>(loc._register); 
-        else return CreateRef<PointerArg>(Register::RBP, loc.stack_offset); 
+        if (!IsPointer(src) || !IsPointer(dst) || IsSameRegister(src, dst)) return; 
+        auto _reg = allocator.AllocRegister();
+        m_CodeGenerator.EmitOp(OpInstruction::MOV, src, RegisterArg(_reg)); 
+        src = CreateRef<RegisterArg>(_reg); 
+        allocator.FreeRegister(_reg);
     }
 
-    AssemblyArg::Ref FetchVarLocation(TAC::Operand::Ref operand)
+    AssemblyArg::Ref FetchVarLocation(TAC::Operand operand)
     {
-        if (operand->type() == TAC::OperandType::Constant)
-            return CreateRef<ImmediateArg>(operand->get_value());
+        if (operand.type == TAC::OperandType::Constant)
+            return CreateRef<ImmediateArg>(operand.value);
         else {
-            auto loc = m_LocationTable[operand->get_symbol()];
+            const auto& loc = GetLocation(operand);
             if (loc.type() == VarLocation::Type::Register)
                 return CreateRef<RegisterArg>(loc._register); 
             else return CreateRef<PointerArg>(Register::RBP, loc.stack_offset); 
         }
     }
+
+    static LabelArg FetchLabel(TAC::Operand label)
+    {
+        return LabelArg(TAC::label_name(label.id())); 
+    }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdexcept>
 #include <unordered_map>
 
 #include "register.hpp"
@@ -24,6 +25,9 @@ public:
                 return iter.first; 
             }
         }
+        // temporaries are never spilled, so an expression needing more live
+        // values than there are registers cannot be compiled
+        throw std::runtime_error("error: Expression too complex, out of registers"); 
     }
 
     void AllocRegister(Register _reg)
@@ -90,6 +94,44 @@ public:
             case Register::RDX:
                 return !(m_UsedRegisters[Register::RDX] || m_UsedRegisters[Register::EDX] || m_UsedRegisters[Register::DX] ||
                     m_UsedRegisters[Register::DL] || m_UsedRegisters[Register::DH]);
+            // the remaining caller-saved registers, which functions may use
+            // without saving them
+            case Register::SIL:
+            case Register::SI:
+            case Register::ESI:
+            case Register::RSI:
+                return !(m_UsedRegisters[Register::RSI] || m_UsedRegisters[Register::ESI] || m_UsedRegisters[Register::SI] ||
+                    m_UsedRegisters[Register::SIL]);
+            case Register::DIL:
+            case Register::DI:
+            case Register::EDI:
+            case Register::RDI:
+                return !(m_UsedRegisters[Register::RDI] || m_UsedRegisters[Register::EDI] || m_UsedRegisters[Register::DI] ||
+                    m_UsedRegisters[Register::DIL]);
+            case Register::R8B:
+            case Register::R8W:
+            case Register::R8D:
+            case Register::R8:
+                return !(m_UsedRegisters[Register::R8] || m_UsedRegisters[Register::R8D] || m_UsedRegisters[Register::R8W] ||
+                    m_UsedRegisters[Register::R8B]);
+            case Register::R9B:
+            case Register::R9W:
+            case Register::R9D:
+            case Register::R9:
+                return !(m_UsedRegisters[Register::R9] || m_UsedRegisters[Register::R9D] || m_UsedRegisters[Register::R9W] ||
+                    m_UsedRegisters[Register::R9B]);
+            case Register::R10B:
+            case Register::R10W:
+            case Register::R10D:
+            case Register::R10:
+                return !(m_UsedRegisters[Register::R10] || m_UsedRegisters[Register::R10D] || m_UsedRegisters[Register::R10W] ||
+                    m_UsedRegisters[Register::R10B]);
+            case Register::R11B:
+            case Register::R11W:
+            case Register::R11D:
+            case Register::R11:
+                return !(m_UsedRegisters[Register::R11] || m_UsedRegisters[Register::R11D] || m_UsedRegisters[Register::R11W] ||
+                    m_UsedRegisters[Register::R11B]);
         }
         return false;
     }
@@ -105,6 +147,7 @@ private:
         { Register::DH,   false },   
         { Register::DL,   false },   
         { Register::SIL,  false },  
+        { Register::DIL,  false },  
         { Register::BPL,  false },  
         { Register::SPL,  false },  
         { Register::R8B,  false },  
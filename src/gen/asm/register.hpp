@@ -4,6 +4,7 @@
 #include <optional>
 #include <stdexcept>
 
+#include "compiler/log.hpp"
 #include "operand_size.hpp"
 
 enum class Register : int
@@ -207,7 +208,7 @@ namespace RegisterUtility
             case Register::R14:  return OperandSize::QWORD;
             case Register::R15:  return OperandSize::QWORD;
         }
-        std::cout << "warning: Unknown size for register '" + to_string(_register) + "'\n";
+        LOG(ASM, Warn) << "warning: Unknown size for register '" + to_string(_register) + "'\n";
         return OperandSize::BYTE;
     }
 
@@ -284,7 +285,7 @@ namespace RegisterUtility
             case Register::R15D:
             case Register::R15:  return Register::R15B;
         }
-        std::cerr << "error: Cannot get lower byte for register '" << to_string(_reg) << "'\n";
+        LOG(ASM, Error) << "error: Cannot get lower byte for register '" << to_string(_reg) << "'\n";
         return Register::AL;
     }
 };
\ No newline at end of file
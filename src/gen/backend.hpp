@@ -1,11 +1,16 @@
 #pragma once
 
 #include <assert.h>
+#include <fstream>
 #include <memory>
 
+#include "compiler/log.hpp"
 #include "gen/asm.hpp"
 #include "gen/code_gen.hpp"
 #include "gen/def.hpp"
+#include "ir/cfg.hpp"
+#include "ir/dce.hpp"
+#include "ir/ssa.hpp"
 #include "ir/tac.hpp"
 
 class CompilerBackend
@@ -23,11 +28,11 @@ class CompilerBackend
             #endif
         }
 
-        bool GenerateCode(CompilerFlags flags, AbstractSyntax::Ref ast)
+        bool GenerateCode(const CompilerFlags& flags, AbstractSyntax::Ref ast, StringInterner& names)
         {
             if (ast == nullptr) return false; 
             // TAC generation
-            TACGenerator generator{};
+            TACGenerator generator{ names };
             try 
             {
                 generator.GenerateStatements(ast); 
@@ -36,14 +41,45 @@ class CompilerBackend
                 std::cerr << exc.what() << std::endl; 
                 return false; 
             }
-            generator.LogStatements();
+            if (LOG_ENABLED(TAC, Info))
+                generator.LogStatements(Log::Stream(LogLevel::Info));
+            auto program = generator.TakeProgram(); 
+            if (LOG_ENABLED(CFG, Info))
+            {
+                for (const auto& function : program.functions)
+                {
+                    auto& out = Log::Stream(LogLevel::Info); 
+                    out << names.Lookup(function->function_name) << ":\n"; 
+                    TAC::ControlFlowGraph(*function).Print(out); 
+                }
+            }
+            // at -O1 copies between variables are propagated in SSA form;
+            // lowering coalesces the versions back into their variables where
+            // they do not overlap, and the copies left dead and any other dead
+            // assignments are dropped from the lowered code
+            if (flags.optimize >= 1)
+            {
+                for (auto& function : program.functions)
+                {
+                    TAC::SSAForm ssa{ *function }; 
+                    ssa.PropagateCopies(); 
+                    if (LOG_ENABLED(SSA, Info))
+                    {
+                        auto& out = Log::Stream(LogLevel::Info); 
+                        out << names.Lookup(function->function_name) << ":\n"; 
+                        ssa.Print(out, names); 
+                    }
+                    ssa.Lower(); 
+                    TAC::eliminate_dead_code(*function); 
+                }
+            }
             // output
             auto outputpath = flags.outputpath + ".s"; 
             auto os = std::make_shared<std::ofstream>(outputpath); 
             m_CodeGenerator->SetOutputStream(os);
             try 
             {
-                m_ASMGenerator->GenerateAssembly(generator); 
+                m_ASMGenerator->GenerateAssembly(program, names); 
             } catch (const std::exception& exc)
             {
                 std::cerr << exc.what() << std::endl; 
@@ -53,6 +89,8 @@ class CompilerBackend
                 return false; 
             }
             os->close(); 
+            if (LOG_ENABLED(ASM, Info))
+                Log::Stream(LogLevel::Info) << std::ifstream(outputpath).rdbuf(); 
             m_Assembler->AssembleProgram(flags.outputpath + ".s", flags.outputpath);
             return true;
         }
@@ -0,0 +1,769 @@
+#include "constant_opt.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace
+{
+    // loops assigning more names than this forget every value on entry
+    // rather than each name, so deeply nested loops fold in linear time
+    constexpr size_t MAX_LOOP_WRITES = 4096;
+
+    int Wrap(uint32_t value)
+    {
+        return static_cast<int>(value);
+    }
+
+    // lhs op rhs as the emitted code computes it, or nothing when C leaves
+    // the result undefined in a way the hardware does not paper over
+    std::optional<int> FoldBinary(BinaryOpType type, int lhs, int rhs)
+    {
+        auto l = static_cast<uint32_t>(lhs), r = static_cast<uint32_t>(rhs);
+        switch (type)
+        {
+            case BinaryOpType::Addition:           return Wrap(l + r);
+            case BinaryOpType::Subtraction:        return Wrap(l - r);
+            case BinaryOpType::Multiplication:     return Wrap(l * r);
+            case BinaryOpType::Division:
+            case BinaryOpType::Remainder:
+                // idiv traps on both
+                if (rhs == 0 || (lhs == INT_MIN && rhs == -1)) return std::nullopt;
+                return type == BinaryOpType::Division ? lhs / rhs : lhs % rhs;
+            case BinaryOpType::BitwiseLeftShift:
+            case BinaryOpType::BitwiseRightShift:
+                // sal and sar mask the count, C does not define it
+                if (rhs < 0 || rhs > 31) return std::nullopt;
+                return type == BinaryOpType::BitwiseLeftShift ? Wrap(l << rhs) : lhs >> rhs;
+            case BinaryOpType::BitwiseAnd:         return lhs & rhs;
+            case BinaryOpType::BitwiseOr:          return lhs | rhs;
+            case BinaryOpType::BitwiseXOR:         return lhs ^ rhs;
+            case BinaryOpType::LogicalAnd:         return lhs && rhs;
+            case BinaryOpType::LogicalOr:          return lhs || rhs;
+            case BinaryOpType::Equal:              return lhs == rhs;
+            case BinaryOpType::NotEqual:           return lhs != rhs;
+            case BinaryOpType::LessThan:           return lhs < rhs;
+            case BinaryOpType::LessThanOrEqual:    return lhs <= rhs;
+            case BinaryOpType::GreaterThan:        return lhs > rhs;
+            case BinaryOpType::GreaterThanOrEqual: return lhs >= rhs;
+            case BinaryOpType::Comma:              return rhs;
+        }
+        return std::nullopt;
+    }
+
+    BinaryOpType ConvertAssignmentOp(AssignmentOpType type)
+    {
+        switch (type)
+        {
+            case AssignmentOpType::Add:            return BinaryOpType::Addition;
+            case AssignmentOpType::Minus:          return BinaryOpType::Subtraction;
+            case AssignmentOpType::Multiplication: return BinaryOpType::Multiplication;
+            case AssignmentOpType::Division:       return BinaryOpType::Division;
+            case AssignmentOpType::Modulo:         return BinaryOpType::Remainder;
+            case AssignmentOpType::LeftShift:      return BinaryOpType::BitwiseLeftShift;
+            case AssignmentOpType::RightShift:     return BinaryOpType::BitwiseRightShift;
+            // |= and &= are bitwise despite the enum names
+            case AssignmentOpType::LogicalOr:      return BinaryOpType::BitwiseOr;
+            case AssignmentOpType::LogicalAnd:     return BinaryOpType::BitwiseAnd;
+            case AssignmentOpType::LogicalXOR:     return BinaryOpType::BitwiseXOR;
+        }
+        return BinaryOpType::Comma;
+    }
+
+    bool IsIncrementOrDecrement(UnaryOpType type)
+    {
+        return type == UnaryOpType::PrefixIncrement || type == UnaryOpType::PostfixIncrement ||
+            type == UnaryOpType::PrefixDecrement || type == UnaryOpType::PostfixDecrement;
+    }
+}
+
+void ConstantFolder::FoldProgram(AbstractSyntax::Ref root)
+{
+    if (root == nullptr) return;
+    if (root->type() == SyntaxType::Program)
+        FoldFunction(AbstractSyntax::RefCast<Program>(root)->function);
+    else if (root->type() == SyntaxType::Function)
+        FoldFunction(AbstractSyntax::RefCast<Function>(root));
+}
+
+void ConstantFolder::FoldFunction(Function::Ref function)
+{
+    if (function == nullptr) return;
+    CollectLoopWrites(function);
+    // statements are folded off an explicit stack of tasks, like the TAC
+    // generator walks them, so deep nesting cannot overflow the native stack
+    Statement::Ref body = function->block;
+    std::vector<FoldTask> tasks{ FoldTask(&body) };
+    while (!tasks.empty())
+    {
+        auto task = std::move(tasks.back());
+        tasks.pop_back();
+        if (task.slot != nullptr) FoldStatement(task.slot, tasks);
+        else task.action();
+    }
+
+    m_Symbols.clear();
+    m_Values.clear();
+    m_Trail.clear();
+    m_LoopWrites.clear();
+    m_Loops.clear();
+    m_Floor = 0;
+    m_Reachable = true;
+}
+
+void ConstantFolder::CollectLoopWrites(Function::Ref function)
+{
+    // Pre-order walk recording every assigned name. A loop's condition, body
+    // and post expression are walked between its begin and end markers, so
+    // the names they assign form one slice of m_LoopWrites; the init clause
+    // of a for loop runs once and is walked before the begin marker.
+    enum Step : uint8_t { Visit, LoopBegin, LoopEnd };
+    std::vector<std::pair<AbstractSyntax::Ref, Step>> stack{ { function->block, Visit } };
+    auto visit = [&stack](AbstractSyntax::Ref syntax)
+    {
+        if (syntax != nullptr) stack.emplace_back(syntax, Visit);
+    };
+    auto loop = [&stack, &visit](AbstractSyntax::Ref syntax, std::initializer_list<AbstractSyntax::Ref> parts, AbstractSyntax::Ref init)
+    {
+        stack.emplace_back(syntax, LoopEnd);
+        for (auto part : parts) visit(part);
+        stack.emplace_back(syntax, LoopBegin);
+        visit(init);
+    };
+    while (!stack.empty())
+    {
+        auto [syntax, step] = stack.back();
+        stack.pop_back();
+        if (step == LoopBegin)
+        {
+            m_Loops[syntax].begin = m_LoopWrites.size();
+            continue;
+        }
+        if (step == LoopEnd)
+        {
+            m_Loops[syntax].end = m_LoopWrites.size();
+            continue;
+        }
+        switch (syntax->type())
+        {
+            case SyntaxType::CompoundBlock:
+                for (auto statement : AbstractSyntax::RefCast<CompoundBlock>(syntax)->statements)
+                    visit(statement);
+                break;
+            case SyntaxType::Declaration:
+                for (auto& var : AbstractSyntax::RefCast<Declaration>(syntax)->variables)
+                    visit(var.expression);
+                break;
+            case SyntaxType::StatementExpression:
+                visit(AbstractSyntax::RefCast<StatementExpression>(syntax)->expression);
+                break;
+            case SyntaxType::Return:
+                visit(AbstractSyntax::RefCast<ReturnStatement>(syntax)->expression);
+                break;
+            case SyntaxType::IfStatement:
+            {
+                auto statement = AbstractSyntax::RefCast<IfStatement>(syntax);
+                visit(statement->if_conditional.condition);
+                visit(statement->if_conditional.statement);
+                for (auto& conditional : statement->else_ifs)
+                {
+                    visit(conditional.condition);
+                    visit(conditional.statement);
+                }
+                visit(statement->else_statement);
+                break;
+            }
+            case SyntaxType::While:
+            {
+                auto statement = AbstractSyntax::RefCast<WhileStatement>(syntax);
+                loop(syntax, { statement->condition, statement->body }, nullptr);
+                break;
+            }
+            case SyntaxType::DoWhile:
+            {
+                auto statement = AbstractSyntax::RefCast<DoWhileStatement>(syntax);
+                loop(syntax, { statement->body, statement->condition }, nullptr);
+                break;
+            }
+            case SyntaxType::For:
+            {
+                auto statement = AbstractSyntax::RefCast<ForStatement>(syntax);
+                loop(syntax, { statement->condition, statement->body, statement->post_expression }, statement->expression);
+                break;
+            }
+            case SyntaxType::ForDecl:
+            {
+                auto statement = AbstractSyntax::RefCast<ForDeclStatement>(syntax);
+                loop(syntax, { statement->condition, statement->body, statement->post_expression }, statement->declaration);
+                break;
+            }
+            case SyntaxType::UnaryOp:
+            {
+                auto op = AbstractSyntax::RefCast<UnaryOp>(syntax);
+                if (IsIncrementOrDecrement(op->OpType()) && op->expr->type() == SyntaxType::VariableRef)
+                    m_LoopWrites.push_back(AbstractSyntax::RefCast<VariableRef>(op->expr)->name);
+                else visit(op->expr);
+                break;
+            }
+            case SyntaxType::BinaryOp:
+            {
+                auto op = AbstractSyntax::RefCast<BinaryOp>(syntax);
+                visit(op->lvalue);
+                visit(op->rvalue);
+                break;
+            }
+            case SyntaxType::TernaryOp:
+            {
+                auto op = AbstractSyntax::RefCast<TernaryOp>(syntax);
+                visit(op->condition);
+                visit(op->lvalue);
+                visit(op->rvalue);
+                break;
+            }
+            case SyntaxType::Assignment:
+            {
+                auto assignment = AbstractSyntax::RefCast<Assignment>(syntax);
+                m_LoopWrites.push_back(assignment->lvalue);
+                visit(assignment->rvalue);
+                break;
+            }
+            case SyntaxType::AssignmentOp:
+            {
+                auto op = AbstractSyntax::RefCast<AssignmentOp>(syntax);
+                m_LoopWrites.push_back(op->lvalue);
+                visit(op->rvalue);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void ConstantFolder::Schedule(std::vector<FoldTask>& tasks, std::vector<FoldTask> steps)
+{
+    // the stack runs last in, first out
+    tasks.insert(tasks.end(), std::make_move_iterator(steps.rbegin()), std::make_move_iterator(steps.rend()));
+}
+
+void ConstantFolder::FoldStatement(Statement::Ref* slot, std::vector<FoldTask>& tasks)
+{
+    auto syntax = *slot;
+    switch (syntax->type())
+    {
+        case SyntaxType::CompoundBlock:
+        {
+            auto block = AbstractSyntax::RefCast<CompoundBlock>(syntax);
+            m_Scopes.push_scope();
+            std::vector<FoldTask> steps;
+            for (auto& statement : block->statements)
+                steps.emplace_back(&statement);
+            steps.emplace_back([this]() { m_Scopes.pop_scope(); });
+            Schedule(tasks, std::move(steps));
+            break;
+        }
+        case SyntaxType::Declaration:
+            FoldDeclaration(AbstractSyntax::RefCast<Declaration>(syntax));
+            break;
+        case SyntaxType::StatementExpression:
+        {
+            auto statement = AbstractSyntax::RefCast<StatementExpression>(syntax);
+            statement->expression = FoldExpression(statement->expression);
+            break;
+        }
+        case SyntaxType::Return:
+        {
+            auto statement = AbstractSyntax::RefCast<ReturnStatement>(syntax);
+            statement->expression = FoldExpression(statement->expression);
+            m_Reachable = false;
+            break;
+        }
+        // checked here as well, the statement may be folded away before the
+        // TAC generator gets to it
+        case SyntaxType::Break:
+            m_Scopes.get_end_label();
+            m_Reachable = false;
+            break;
+        case SyntaxType::Continue:
+            m_Scopes.get_start_label();
+            m_Reachable = false;
+            break;
+        case SyntaxType::IfStatement:
+        {
+            // An else if condition only runs once the ones before it fail, so
+            // the chain folds as nested forks: each condition splits into its
+            // branch and the rest of the chain.
+            auto statement = AbstractSyntax::RefCast<IfStatement>(syntax);
+            std::vector<Conditional*> chain{ &statement->if_conditional };
+            for (auto& conditional : statement->else_ifs)
+                chain.push_back(&conditional);
+
+            std::vector<FoldTask> steps;
+            for (auto conditional : chain)
+            {
+                steps.emplace_back([this, conditional]()
+                {
+                    conditional->condition = FoldExpression(conditional->condition);
+                    auto value = Constant(conditional->condition);
+                    BeginFork();
+                    BeginBranch(!(value && *value == 0));
+                });
+                steps.emplace_back(&conditional->statement);
+                steps.emplace_back([this, conditional]()
+                {
+                    EndBranch();
+                    auto value = Constant(conditional->condition);
+                    BeginBranch(!(value && *value != 0));
+                });
+            }
+            if (statement->else_statement != nullptr)
+                steps.emplace_back(&statement->else_statement);
+            for (size_t i = 0; i < chain.size(); i++)
+            {
+                steps.emplace_back([this]()
+                {
+                    EndBranch();
+                    EndFork();
+                });
+            }
+            // conditions that fold to 0 can be dropped up to the first one
+            // that folds to non-zero, whose branch is the one left
+            steps.emplace_back([this, slot, statement, chain]()
+            {
+                Statement::Ref* chosen = &statement->else_statement;
+                for (auto conditional : chain)
+                {
+                    auto value = Constant(conditional->condition);
+                    if (!value) return;
+                    if (*value == 0) continue;
+                    chosen = &conditional->statement;
+                    break;
+                }
+                *slot = *chosen != nullptr ? *chosen : EmptyStatement();
+            });
+            Schedule(tasks, std::move(steps));
+            break;
+        }
+        case SyntaxType::While:
+        {
+            auto loop = AbstractSyntax::RefCast<WhileStatement>(syntax);
+            EnterLoop(syntax);
+            auto entry = Save();
+            loop->condition = FoldExpression(loop->condition);
+            auto condition = Constant(loop->condition);
+            bool runs = !(condition && *condition == 0);
+            m_Reachable = entry.reachable && runs;
+            // only marks the loop for break and continue, the labels are the
+            // TAC generator's
+            m_Scopes.push_scope(0, 0);
+            Schedule(tasks, { &loop->body, FoldTask([this, slot, entry, runs]()
+            {
+                m_Scopes.pop_scope();
+                Restore(entry);
+                if (!runs) *slot = EmptyStatement();
+            }) });
+            break;
+        }
+        case SyntaxType::DoWhile:
+        {
+            auto loop = AbstractSyntax::RefCast<DoWhileStatement>(syntax);
+            EnterLoop(syntax);
+            auto entry = Save();
+            m_Scopes.push_scope(0, 0);
+            Schedule(tasks, { &loop->body, FoldTask([this, loop, entry]()
+            {
+                m_Scopes.pop_scope();
+                // the loop entry state holds on every iteration
+                Restore(entry);
+                loop->condition = FoldExpression(loop->condition);
+                Restore(entry);
+            }) });
+            break;
+        }
+        case SyntaxType::For:
+        case SyntaxType::ForDecl:
+        {
+            Expression::Ref* condition;
+            Expression::Ref* post_expression;
+            Statement::Ref* body;
+            m_Scopes.push_scope(0, 0);
+            if (syntax->type() == SyntaxType::For)
+            {
+                auto loop = AbstractSyntax::RefCast<ForStatement>(syntax);
+                loop->expression = FoldExpression(loop->expression);
+                condition = &loop->condition;
+                post_expression = &loop->post_expression;
+                body = &loop->body;
+            } else {
+                auto loop = AbstractSyntax::RefCast<ForDeclStatement>(syntax);
+                FoldDeclaration(loop->declaration);
+                condition = &loop->condition;
+                post_expression = &loop->post_expression;
+                body = &loop->body;
+            }
+            EnterLoop(syntax);
+            auto entry = Save();
+            *condition = FoldExpression(*condition);
+            auto value = Constant(*condition);
+            m_Reachable = entry.reachable && !(value && *value == 0);
+            Schedule(tasks, { body, FoldTask([this, post_expression, entry]()
+            {
+                // continue jumps straight to the post expression
+                Restore(entry);
+                *post_expression = FoldExpression(*post_expression);
+                Restore(entry);
+                m_Scopes.pop_scope();
+            }) });
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ConstantFolder::FoldDeclaration(Declaration::Ref declaration)
+{
+    for (auto& var : declaration->variables)
+    {
+        // the name is in scope in its own initializer
+        auto symbol = CreateRef<VarSymbol>(var.name, declaration->type_size);
+        m_Scopes.add_var(var.name, symbol);
+        m_Symbols.push_back(symbol);
+        Assign(symbol.get(), std::nullopt);
+        if (var.expression == nullptr) continue;
+        var.expression = FoldExpression(var.expression);
+        Assign(symbol.get(), Constant(var.expression));
+    }
+}
+
+Expression::Ref ConstantFolder::FoldExpression(Expression::Ref expr)
+{
+    if (expr == nullptr) return nullptr;
+    // operands are folded off an explicit stack of frames instead of
+    // recursing, so deeply nested expressions cannot overflow the native one
+    auto& frames = m_Frames;
+    frames.clear();
+    frames.emplace_back(expr);
+    Expression::Ref result = nullptr;
+    while (!frames.empty())
+    {
+        Expression::Ref operand = nullptr;
+        if (FoldStep(frames.back(), result, operand)) frames.pop_back();
+        else frames.emplace_back(operand);
+    }
+    return result;
+}
+
+// Advances frame by one step. Returns true once the frame is folded into
+// result; otherwise sets operand to the child that has to be folded first,
+// whose folded form is in result on the next call.
+bool ConstantFolder::FoldStep(FoldFrame& frame, Expression::Ref& result, Expression::Ref& operand)
+{
+    auto expr = frame.expr;
+    auto state = frame.state++;
+    switch (expr->type())
+    {
+        case SyntaxType::VariableRef:
+        {
+            auto symbol = m_Scopes.get_var(AbstractSyntax::RefCast<VariableRef>(expr)->name);
+            auto value = Known(symbol.get());
+            result = value ? m_Arena.Create<IntConstant>(*value) : expr;
+            return true;
+        }
+        case SyntaxType::UnaryOp:
+        {
+            auto op = AbstractSyntax::RefCast<UnaryOp>(expr);
+            if (IsIncrementOrDecrement(op->OpType()))
+            {
+                // the operand has to stay a variable, only its value is tracked
+                auto symbol = m_Scopes.get_var(AbstractSyntax::RefCast<VariableRef>(op->expr)->name).get();
+                bool increment = op->OpType() == UnaryOpType::PrefixIncrement || op->OpType() == UnaryOpType::PostfixIncrement;
+                auto value = Known(symbol);
+                Assign(symbol, value ? std::optional<int>(Wrap(static_cast<uint32_t>(*value) + (increment ? 1u : ~0u))) : std::nullopt);
+                result = expr;
+                return true;
+            }
+            if (state == 0)
+            {
+                operand = op->expr;
+                return false;
+            }
+            op->expr = result;
+            result = expr;
+            auto value = Constant(op->expr);
+            if (!value) return true;
+            switch (op->OpType())
+            {
+                case UnaryOpType::Negation:
+                    result = m_Arena.Create<IntConstant>(Wrap(0u - static_cast<uint32_t>(*value)));
+                    break;
+                case UnaryOpType::Complement:
+                    result = m_Arena.Create<IntConstant>(~*value);
+                    break;
+                case UnaryOpType::LogicalNegation:
+                    result = m_Arena.Create<IntConstant>(!*value);
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        }
+        case SyntaxType::BinaryOp:
+        {
+            auto op = AbstractSyntax::RefCast<BinaryOp>(expr);
+            bool logical = op->OpType() == BinaryOpType::LogicalAnd || op->OpType() == BinaryOpType::LogicalOr;
+            // whether a constant left operand settles && or || on its own
+            auto decides = [op](std::optional<int> lhs)
+            {
+                return lhs && (*lhs != 0) == (op->OpType() == BinaryOpType::LogicalOr);
+            };
+            if (state == 0)
+            {
+                operand = op->lvalue;
+                return false;
+            }
+            if (state == 1)
+            {
+                op->lvalue = result;
+                if (logical)
+                {
+                    // the right operand only runs when the left one does not decide
+                    BeginFork();
+                    BeginBranch(!decides(Constant(op->lvalue)));
+                }
+                operand = op->rvalue;
+                return false;
+            }
+            op->rvalue = result;
+            result = expr;
+            auto lhs = Constant(op->lvalue), rhs = Constant(op->rvalue);
+            if (logical)
+            {
+                EndBranch();
+                // the path that skips the right operand
+                BeginBranch(!lhs || decides(lhs));
+                EndBranch();
+                EndFork();
+                if (decides(lhs)) result = m_Arena.Create<IntConstant>(*lhs != 0);
+                else if (lhs && rhs) result = m_Arena.Create<IntConstant>(*rhs != 0);
+                return true;
+            }
+            if (op->OpType() == BinaryOpType::Comma)
+            {
+                // a literal on the left has no effect
+                if (lhs) result = op->rvalue;
+                return true;
+            }
+            if (lhs && rhs)
+            {
+                if (auto value = FoldBinary(op->OpType(), *lhs, *rhs))
+                    result = m_Arena.Create<IntConstant>(*value);
+            }
+            return true;
+        }
+        case SyntaxType::TernaryOp:
+        {
+            auto op = AbstractSyntax::RefCast<TernaryOp>(expr);
+            // rvalue is the false branch; it is folded first, in the TAC
+            // generator's order
+            switch (state)
+            {
+                case 0:
+                    operand = op->condition;
+                    return false;
+                case 1:
+                {
+                    op->condition = result;
+                    auto condition = Constant(op->condition);
+                    BeginFork();
+                    BeginBranch(!condition || *condition == 0);
+                    operand = op->rvalue;
+                    return false;
+                }
+                case 2:
+                {
+                    op->rvalue = result;
+                    EndBranch();
+                    auto condition = Constant(op->condition);
+                    BeginBranch(!condition || *condition != 0);
+                    operand = op->lvalue;
+                    return false;
+                }
+            }
+            op->lvalue = result;
+            EndBranch();
+            EndFork();
+            auto condition = Constant(op->condition);
+            result = !condition ? expr : *condition != 0 ? op->lvalue : op->rvalue;
+            return true;
+        }
+        case SyntaxType::Assignment:
+        {
+            auto assignment = AbstractSyntax::RefCast<Assignment>(expr);
+            if (state == 0)
+            {
+                frame.symbol = m_Scopes.get_var(assignment->lvalue).get();
+                operand = assignment->rvalue;
+                return false;
+            }
+            assignment->rvalue = result;
+            Assign(frame.symbol, Constant(assignment->rvalue));
+            result = expr;
+            return true;
+        }
+        case SyntaxType::AssignmentOp:
+        {
+            auto op = AbstractSyntax::RefCast<AssignmentOp>(expr);
+            if (state == 0)
+            {
+                frame.symbol = m_Scopes.get_var(op->lvalue).get();
+                operand = op->rvalue;
+                return false;
+            }
+            op->rvalue = result;
+            std::optional<int> value;
+            auto lhs = Known(frame.symbol), rhs = Constant(op->rvalue);
+            if (lhs && rhs) value = FoldBinary(ConvertAssignmentOp(op->OpType()), *lhs, *rhs);
+            Assign(frame.symbol, value);
+            // with both sides known it is a plain store of the result
+            result = value ? m_Arena.Create<Assignment>(op->lvalue, m_Arena.Create<IntConstant>(*value)) : expr;
+            return true;
+        }
+        default:
+            result = expr;
+            return true;
+    }
+}
+
+ConstantFolder::Value ConstantFolder::Fact(VarSymbol* symbol, uint32_t floor) const
+{
+    auto iter = m_Values.find(symbol);
+    if (iter == m_Values.end() || iter->second.generation < floor) return Value{};
+    return iter->second;
+}
+
+std::optional<int> ConstantFolder::Known(VarSymbol* symbol) const
+{
+    auto fact = Fact(symbol, m_Floor);
+    if (!fact.known) return std::nullopt;
+    return fact.value;
+}
+
+void ConstantFolder::Assign(VarSymbol* symbol, std::optional<int> value)
+{
+    auto& fact = m_Values[symbol];
+    m_Trail.push_back({ symbol, fact });
+    fact = value ? Value{ true, *value, ++m_Generation } : Value{};
+}
+
+void ConstantFolder::Rollback(size_t mark)
+{
+    for (; m_Trail.size() > mark; m_Trail.pop_back())
+        m_Values[m_Trail.back().symbol] = m_Trail.back().previous;
+}
+
+ConstantFolder::Snapshot ConstantFolder::Save() const
+{
+    return Snapshot{ m_Trail.size(), m_Floor, m_Reachable };
+}
+
+void ConstantFolder::Restore(const Snapshot& snapshot)
+{
+    Rollback(snapshot.mark);
+    m_Floor = snapshot.floor;
+    m_Reachable = snapshot.reachable;
+}
+
+void ConstantFolder::EnterLoop(AbstractSyntax::Ref loop)
+{
+    // whatever the loop assigns may hold another value on the next iteration
+    auto writes = m_Loops[loop];
+    if (writes.end - writes.begin > MAX_LOOP_WRITES)
+    {
+        m_Floor = ++m_Generation;
+        return;
+    }
+    for (size_t i = writes.begin; i < writes.end; i++)
+    {
+        auto name = m_LoopWrites[i];
+        if (m_Scopes.any_scope_has_var(name))
+            Assign(m_Scopes.get_var(name).get(), std::nullopt);
+    }
+}
+
+void ConstantFolder::BeginFork()
+{
+    m_Forks.push_back(Fork{ Save() });
+}
+
+void ConstantFolder::BeginBranch(bool taken)
+{
+    m_Reachable = m_Forks.back().entry.reachable && taken;
+}
+
+void ConstantFolder::EndBranch()
+{
+    auto& fork = m_Forks.back();
+    bool reached = m_Reachable;
+    auto floor = m_Floor;
+    std::unordered_map<VarSymbol*, Value> writes;
+    if (reached)
+    {
+        for (size_t i = fork.entry.mark; i < m_Trail.size(); i++)
+            writes[m_Trail[i].symbol] = Fact(m_Trail[i].symbol, floor);
+    }
+    Restore(fork.entry);
+    if (!reached) return;
+
+    // with the fork's state restored, names this branch did not assign
+    // read as they were at the fork
+    auto meet = [](const Value& a, const Value& b)
+    {
+        return a.known && b.known && a.value == b.value ? a : Value{};
+    };
+    if (!fork.joined_any)
+    {
+        fork.joined = std::move(writes);
+        fork.joined_floor = floor;
+        fork.joined_any = true;
+        return;
+    }
+    for (auto& [symbol, value] : fork.joined)
+    {
+        if (writes.find(symbol) == writes.end())
+            value = meet(value, Fact(symbol, floor));
+    }
+    for (auto& [symbol, value] : writes)
+    {
+        auto iter = fork.joined.find(symbol);
+        auto before = iter != fork.joined.end() ? iter->second : Fact(symbol, fork.joined_floor);
+        fork.joined[symbol] = meet(before, value);
+    }
+    fork.joined_floor = std::max(fork.joined_floor, floor);
+}
+
+void ConstantFolder::EndFork()
+{
+    auto fork = std::move(m_Forks.back());
+    m_Forks.pop_back();
+    if (!fork.joined_any)
+    {
+        // no branch gets here
+        m_Reachable = false;
+        return;
+    }
+    for (auto& [symbol, value] : fork.joined)
+        Assign(symbol, value.known ? std::optional<int>(value.value) : std::nullopt);
+    m_Floor = fork.joined_floor;
+    m_Reachable = true;
+}
+
+Statement::Ref ConstantFolder::EmptyStatement()
+{
+    return m_Arena.Create<CompoundBlock>(ArenaArray<Statement::Ref>());
+}
+
+std::optional<int> ConstantFolder::Constant(Expression::Ref expr)
+{
+    if (expr == nullptr || expr->type() != SyntaxType::IntConstant) return std::nullopt;
+    return AbstractSyntax::RefCast<IntConstant>(expr)->value;
+}
@@ -1,274 +1,144 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
-namespace
-{
-    // take care that variables are popped from map when their value is no longer known
-    // i.e. a = foo();
-    static std::unordered_map<std::string, int> variables;
+#include "ir/context.hpp"
+#include "parser/syntax/includes.hpp"
+#include "utility/arena.hpp"
 
-    static bool is_constant(AbstractSyntax::Ref syntax)
+// Constant folding and propagation on the syntax tree, run at -O1.
+//
+// Walks a function in evaluation order, keeping the value of every variable
+// that is known at the current point. Reads of known variables become
+// literals, operations on literals are computed, and if statements, while
+// loops and ternaries whose conditions fold are reduced to the branch that
+// runs. Side effects are never dropped: only literals are folded away.
+//
+// Arithmetic is that of the emitted code, 32-bit two's complement with
+// wraparound. Operations whose result is undefined or traps (division by
+// zero, INT_MIN / -1, shift counts outside 0..31) are left to run.
+//
+// All state lives in the folder, so separate folders may run concurrently on
+// different functions as long as each is given its own arena.
+class ConstantFolder
+{
+public:
+    // folded nodes are allocated in arena, which has to live as long as the
+    // tree; names only spell diagnostics
+    ConstantFolder(Arena& arena, const StringInterner& names) : m_Arena(arena), m_Scopes(names)
     {
-        if (syntax == nullptr) return false;
-        return syntax->type() == SyntaxType::IntConstant; 
     }
 
-    static bool variable_exists(const std::string& var)
+    void FoldProgram(AbstractSyntax::Ref root);
+    void FoldFunction(Function::Ref function);
+
+private:
+    // what is known about a variable; generation orders the facts against
+    // m_Floor, below which every fact counts as unknown
+    struct Value
     {
-        return variables.find(var) != variables.end(); 
-    }
+        bool known = false;
+        int value = 0;
+        uint32_t generation = 0;
+    };
 
-    static void remove_variable(const std::string& var)
+    // undo record of a change to m_Values
+    struct Write
     {
-        auto iter = variables.find(var); 
-        if (iter != variables.end())
-            variables.erase(iter);
-    }
+        VarSymbol* symbol;
+        Value previous;
+    };
+
+    // state to come back to: a point in m_Trail plus what it does not record
+    struct Snapshot
+    {
+        size_t mark;
+        uint32_t floor;
+        bool reachable;
+    };
+
+    // Control flow splitting into branches that meet again. Each branch
+    // starts from the state at the fork and is rolled back when it ends; the
+    // states of the branches that reach the end are met into joined.
+    struct Fork
+    {
+        Snapshot entry;
+        bool joined_any = false;
+        uint32_t joined_floor = 0;
+        std::unordered_map<VarSymbol*, Value> joined{};
+    };
 
-    static std::optional<int> get_value(Expression::Ref expr)
+    // names assigned inside a loop, as a slice of m_LoopWrites
+    struct LoopWrites
     {
-        switch (expr->type())
+        size_t begin, end;
+    };
+
+    // a statement to fold, written back through its slot, or work queued
+    // behind the statements before it
+    struct FoldTask
+    {
+        Statement::Ref* slot = nullptr;
+        std::function<void()> action;
+
+        FoldTask(Statement::Ref* slot) : slot(slot)
         {
-            case SyntaxType::IntConstant:
-                return AbstractSyntax::RefCast<IntConstant>(expr)->value;
-            case SyntaxType::VariableRef:
-            {
-                auto var = AbstractSyntax::RefCast<VariableRef>(expr);
-                if (variable_exists(var->name));
-                    return variables[var->name]; 
-                break;
-            }
-            case SyntaxType::BinaryOp:
-            {
-                auto op = AbstractSyntax::RefCast<BinaryOp>(expr); 
-                if (op->OpType() == BinaryOpType::Comma)
-                    return get_value(op->rvalue); 
-                break;
-            }
-            case SyntaxType::Assignment:
-            {
-                auto assign = AbstractSyntax::RefCast<Assignment>(expr); 
-                if (variable_exists(assign->lvalue));
-                    return variables[assign->lvalue]; 
-                break;
-            }
         }
-        return std::nullopt; 
-    }
 
-    static Expression::Ref FoldConstants(Expression::Ref expr)
-    {
-        if (expr == nullptr) return expr; 
-        switch (expr->type())
+        FoldTask(std::function<void()> action) : action(std::move(action))
         {
-            case SyntaxType::AssignmentOp:
-            {
-                auto op = AbstractSyntax::RefCast<AssignmentOp>(expr); 
-                op->rvalue = FoldConstants(op->rvalue); 
-                auto rconst = get_value(op->rvalue); 
-                if (rconst)
-                {
-                    auto value = rconst.value(); 
-                    if (op->rvalue->type() == SyntaxType::VariableRef)
-                        op->rvalue = CreateRef<IntConstant>(value);
-                    switch (op->OpType())
-                    {
-                        case AssignmentOpType::Add:
-                            variables[op->lvalue] += value;
-                            break;
-                        case AssignmentOpType::Minus:
-                            variables[op->lvalue] -= value;
-                            break;
-                        case AssignmentOpType::Multiplication:
-                            variables[op->lvalue] *= value;
-                            break;
-                        case AssignmentOpType::Division:
-                            variables[op->lvalue] /= value;
-                            break;
-                        case AssignmentOpType::Modulo:
-                            variables[op->lvalue] %= value; 
-                            break;
-                        case AssignmentOpType::LeftShift:
-                            variables[op->lvalue] <<= value;
-                            break;
-                        case AssignmentOpType::RightShift:
-                            variables[op->lvalue] >>= value;
-                            break;
-                        case AssignmentOpType::LogicalOr:
-                            variables[op->lvalue] |= value;
-                            break;
-                        case AssignmentOpType::LogicalAnd:
-                            variables[op->lvalue] &= value;
-                            break;
-                        case AssignmentOpType::LogicalXOR:
-                            variables[op->lvalue] ^= value;
-                            break;
-                    }
-                } else remove_variable(op->lvalue); 
-                break;
-            }
-            case SyntaxType::UnaryOp:
-            {
-                auto op = AbstractSyntax::RefCast<UnaryOp>(expr);
-                op->expr = FoldConstants(op->expr); 
-                auto constant = get_value(op->expr);
-                if (constant)
-                {
-                    switch (op->OpType())
-                    {
-                        case UnaryOpType::Negation: 
-                            return CreateRef<IntConstant>(-constant.value());
-                        case UnaryOpType::Complement:
-                            return CreateRef<IntConstant>(~constant.value()); 
-                        case UnaryOpType::LogicalNegation:
-                            return CreateRef<IntConstant>(!constant.value());  
-                    }
-                }
-                break; 
-            }
-            case SyntaxType::BinaryOp:
-            {
-                auto op = AbstractSyntax::RefCast<BinaryOp>(expr);
-                op->lvalue = FoldConstants(op->lvalue); 
-                auto lconst = get_value(op->lvalue); 
-                // short-circuit logic
-                switch (op->OpType())
-                {
-                    case BinaryOpType::LogicalOr:
-                        if (lconst && lconst.value())
-                            return CreateRef<IntConstant>(1); 
-                        break;
-                    case BinaryOpType::LogicalAnd:
-                        if (lconst && !lconst.value())
-                            return CreateRef<IntConstant>(0);
-                        break;
-                }
-                op->rvalue = FoldConstants(op->rvalue); 
-                auto rconst = get_value(op->rvalue);
-                if (lconst && rconst)
-                {
-                    auto lvalue = lconst.value();
-                    auto rvalue = rconst.value(); 
-                    switch (op->OpType())
-                    {
-                        case BinaryOpType::Addition:
-                            return CreateRef<IntConstant>(lvalue + rvalue);
-                        case BinaryOpType::Subtraction:
-                            return CreateRef<IntConstant>(lvalue - rvalue);
-                        case BinaryOpType::Multiplication:
-                            return CreateRef<IntConstant>(lvalue * rvalue);
-                        case BinaryOpType::Division:
-                            return CreateRef<IntConstant>(lvalue / rvalue);
-                        case BinaryOpType::LogicalOr:
-                            return CreateRef<IntConstant>(lvalue || rvalue);
-                        case BinaryOpType::LogicalAnd:
-                            return CreateRef<IntConstant>(lvalue && rvalue);
-                        case BinaryOpType::Equal:
-                            return CreateRef<IntConstant>(lvalue == rvalue);
-                        case BinaryOpType::NotEqual:
-                            return CreateRef<IntConstant>(lvalue != rvalue);
-                        case BinaryOpType::Remainder:
-                            return CreateRef<IntConstant>(lvalue % rvalue); 
-                        case BinaryOpType::LessThan:
-                            return CreateRef<IntConstant>(lvalue < rvalue);
-                        case BinaryOpType::LessThanOrEqual:
-                            return CreateRef<IntConstant>(lvalue <= rvalue);
-                        case BinaryOpType::GreaterThan:
-                            return CreateRef<IntConstant>(lvalue > rvalue);
-                        case BinaryOpType::GreaterThanOrEqual:
-                            return CreateRef<IntConstant>(lvalue >= rvalue); 
-                        case BinaryOpType::BitwiseOr:
-                            return CreateRef<IntConstant>(lvalue | rvalue);
-                        case BinaryOpType::BitwiseAnd:
-                            return CreateRef<IntConstant>(lvalue & rvalue); 
-                        case BinaryOpType::BitwiseXOR:
-                            return CreateRef<IntConstant>(lvalue ^ rvalue); 
-                        case BinaryOpType::BitwiseLeftShift:
-                            return CreateRef<IntConstant>(lvalue << rvalue);
-                        case BinaryOpType::BitwiseRightShift:
-                            return CreateRef<IntConstant>(lvalue >> rvalue);                             
-                    }
-                } else if (lconst)
-                    return CreateRef<BinaryOp>(op->OpType(), CreateRef<IntConstant>(lconst.value()), op->rvalue); 
-                else if (rconst)
-                    return CreateRef<BinaryOp>(op->OpType(), op->lvalue, CreateRef<IntConstant>(rconst.value())); 
-                break; 
-            }
-            case SyntaxType::VariableRef:
-            {
-                auto var = AbstractSyntax::RefCast<VariableRef>(expr);
-                if (variable_exists(var->name))
-                    return CreateRef<IntConstant>(variables[var->name]);
-                break;
-            }
-            case SyntaxType::Assignment:
-            {
-                auto assign = AbstractSyntax::RefCast<Assignment>(expr); 
-                assign->rvalue = FoldConstants(assign->rvalue); 
-                auto constant = get_value(assign->rvalue);
-                if (constant) variables[assign->lvalue] = constant.value(); 
-                else remove_variable(assign->lvalue); 
-                break;
-            }
         }
-        return expr; 
-    }
+    };
 
-    // Evaluate unary/binary operations that can be reduced to constants in the abstract syntax tree.
-    static AbstractSyntax::Ref EvaluateSyntax(AbstractSyntax::Ref syntax)
+    // an expression whose operands are still being folded
+    struct FoldFrame
     {
-        if (syntax == nullptr) return nullptr; 
-        switch (syntax->type())
+        Expression::Ref expr;
+        uint8_t state = 0;
+        VarSymbol* symbol = nullptr;
+
+        FoldFrame(Expression::Ref expr) : expr(expr)
         {
-            case SyntaxType::Program:
-            {
-                auto program = AbstractSyntax::RefCast<Program>(syntax);
-                EvaluateSyntax(program->function); 
-                break; 
-            }
-            case SyntaxType::Function:
-            {
-                auto function = AbstractSyntax::RefCast<Function>(syntax); 
-                for (auto statement : function->Statements())
-                    EvaluateSyntax(statement); 
-                break; 
-            }
-            case SyntaxType::StatementExpression:
-            {
-                auto statement_expression = AbstractSyntax::RefCast<StatementExpression>(syntax);
-                statement_expression->expression = FoldConstants(statement_expression->expression);
-                break;
-            }
-            case SyntaxType::Declaration:
-            {
-                auto declaration = AbstractSyntax::RefCast<Declaration>(syntax);
-                for (auto var : declaration->variables)
-                {
-                    if (var.expression == nullptr) variables[var.name] = 0; 
-                    else 
-                    {
-                        var.expression = FoldConstants(var.expression); 
-                        auto constant = get_value(var.expression);
-                        if (constant) 
-                            variables[var.name] = constant.value(); 
-                    }
-                }
-                break;
-            }
-            case SyntaxType::Return:
-            {
-                auto return_statement = AbstractSyntax::RefCast<ReturnStatement>(syntax); 
-                return_statement->expression = FoldConstants(return_statement->expression);
-                break; 
-            }
         }
-        return syntax; 
-    }
-};
+    };
 
-static void OptimizeTree(AbstractSyntax::Ref syntax)
-{
-    variables.clear(); 
-    EvaluateSyntax(syntax); 
-}
\ No newline at end of file
+    Arena& m_Arena;
+    VarContext m_Scopes;
+    // every declaration of the function, kept alive so that no two share an address
+    std::vector<VarSymbol::Ref> m_Symbols;
+    std::unordered_map<VarSymbol*, Value> m_Values;
+    std::vector<Write> m_Trail;
+    std::vector<Fork> m_Forks;
+    std::vector<FoldFrame> m_Frames;
+    uint32_t m_Generation = 0, m_Floor = 0;
+    bool m_Reachable = true;
+    std::vector<StringId> m_LoopWrites;
+    std::unordered_map<AbstractSyntax::Ref, LoopWrites> m_Loops;
+
+    void CollectLoopWrites(Function::Ref function);
+    static void Schedule(std::vector<FoldTask>& tasks, std::vector<FoldTask> steps);
+    void FoldStatement(Statement::Ref* slot, std::vector<FoldTask>& tasks);
+    void FoldDeclaration(Declaration::Ref declaration);
+    Expression::Ref FoldExpression(Expression::Ref expr);
+    bool FoldStep(FoldFrame& frame, Expression::Ref& result, Expression::Ref& operand);
+
+    Value Fact(VarSymbol* symbol, uint32_t floor) const;
+    std::optional<int> Known(VarSymbol* symbol) const;
+    void Assign(VarSymbol* symbol, std::optional<int> value);
+    void Rollback(size_t mark);
+    Snapshot Save() const;
+    void Restore(const Snapshot& snapshot);
+    void EnterLoop(AbstractSyntax::Ref loop);
+
+    void BeginFork();
+    void BeginBranch(bool taken);
+    void EndBranch();
+    void EndFork();
+
+    Statement::Ref EmptyStatement();
+    static std::optional<int> Constant(Expression::Ref expr);
+};
@@ -0,0 +1,292 @@
+#include "cfg.hpp"
+
+#include <utility>
+
+namespace TAC
+{
+    namespace
+    {
+        bool EndsBlock(const Statement& statement)
+        {
+            return statement.type == StatementType::Goto || statement.type == StatementType::Condition ||
+                statement.type == StatementType::Return;
+        }
+
+        void PrintBlocks(std::ostream& out, const char* title, ArenaArray<const uint32_t> blocks)
+        {
+            if (blocks.empty()) return;
+            out << " " << title;
+            for (auto block : blocks) out << " B" << block;
+        }
+    }
+
+    ControlFlowGraph::ControlFlowGraph(const Function& function) : m_Function(function)
+    {
+        SplitBlocks();
+        LinkBlocks();
+        OrderBlocks();
+        BuildDominatorTree();
+        FindLoops();
+    }
+
+    bool ControlFlowGraph::InLoop(uint32_t block, uint32_t loop) const
+    {
+        auto current = m_Blocks[block].loop;
+        while (current != NONE && current != loop)
+            current = m_Loops[current].parent;
+        return current == loop;
+    }
+
+    void ControlFlowGraph::Print(std::ostream& out) const
+    {
+        for (uint32_t i = 0; i < m_Blocks.size(); i++)
+        {
+            const auto& block = m_Blocks[i];
+            out << "B" << i << " [" << block.begin << ", " << block.end << ")";
+            if (!IsReachable(i))
+            {
+                out << " unreachable\n";
+                continue;
+            }
+            PrintBlocks(out, "preds", Preds(i));
+            PrintBlocks(out, "succs", Succs(i));
+            if (i != 0) out << " idom B" << block.idom;
+            if (block.loop != NONE)
+                out << " loop B" << m_Loops[block.loop].header << " depth " << m_Loops[block.loop].depth;
+            out << "\n";
+        }
+    }
+
+    uint32_t ControlFlowGraph::CountsToOffsets(std::vector<uint32_t>& offsets)
+    {
+        uint32_t total = 0;
+        for (auto& offset : offsets)
+        {
+            auto count = offset;
+            offset = total;
+            total += count;
+        }
+        return total;
+    }
+
+    void ControlFlowGraph::SplitBlocks()
+    {
+        // a block starts at the first statement, after every jump or return
+        // and at a label, unless only labels precede it in its block
+        const auto& statements = m_Function.statements;
+        auto size = static_cast<uint32_t>(statements.size());
+        m_LabelBlocks.assign(m_Function.label_positions.size(), NONE);
+        uint32_t begin = 0;
+        bool only_labels = true;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            const auto& statement = statements[i];
+            if (statement.type == StatementType::Label)
+            {
+                if (!only_labels)
+                {
+                    m_Blocks.push_back({ begin, i });
+                    begin = i;
+                    only_labels = true;
+                }
+                m_LabelBlocks[statement.dst.id()] = static_cast<uint32_t>(m_Blocks.size());
+                continue;
+            }
+            only_labels = false;
+            if (EndsBlock(statement))
+            {
+                m_Blocks.push_back({ begin, i + 1 });
+                begin = i + 1;
+                only_labels = true;
+            }
+        }
+        // the entry block exists even in a function without statements
+        if (begin < size || m_Blocks.empty())
+            m_Blocks.push_back({ begin, size });
+    }
+
+    void ControlFlowGraph::LinkBlocks()
+    {
+        // every block has at most two successors, found in block order;
+        // the preds are then counted per block and filled in the same order
+        auto count = static_cast<uint32_t>(m_Blocks.size());
+        m_SuccOffsets.resize(count + 1);
+        m_Succs.reserve(2 * count);
+        m_PredOffsets.assign(count + 1, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_SuccOffsets[i] = static_cast<uint32_t>(m_Succs.size());
+            const auto& block = m_Blocks[i];
+            bool falls_through = true;
+            if (block.end > block.begin)
+            {
+                const auto& last = m_Function.statements[block.end - 1];
+                if (last.type == StatementType::Goto || last.type == StatementType::Condition)
+                    m_Succs.push_back(BlockOf(last.dst));
+                falls_through = last.type != StatementType::Goto && last.type != StatementType::Return;
+            }
+            // falling off the last block leaves the function, and a condition
+            // jumping to the statement after it is a single edge
+            if (falls_through && i + 1 < count && (m_Succs.size() == m_SuccOffsets[i] || m_Succs.back() != i + 1))
+                m_Succs.push_back(i + 1);
+            for (auto succ = m_SuccOffsets[i]; succ < m_Succs.size(); succ++)
+                m_PredOffsets[m_Succs[succ]]++;
+        }
+        m_SuccOffsets[count] = static_cast<uint32_t>(m_Succs.size());
+
+        m_Preds.resize(CountsToOffsets(m_PredOffsets));
+        std::vector<uint32_t> filled(m_PredOffsets.begin(), m_PredOffsets.end() - 1);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            for (auto succ : Succs(i)) m_Preds[filled[succ]++] = i;
+        }
+    }
+
+    void ControlFlowGraph::OrderBlocks()
+    {
+        // depth-first walk from the entry with an explicit stack of blocks
+        // and the index of the next successor to visit
+        std::vector<uint32_t> post_order;
+        post_order.reserve(m_Blocks.size());
+        std::vector<bool> visited(m_Blocks.size(), false);
+        std::vector<std::pair<uint32_t, uint32_t>> stack{ { 0, 0 } };
+        visited[0] = true;
+        while (!stack.empty())
+        {
+            auto [block, next] = stack.back();
+            auto succs = Succs(block);
+            if (next < succs.size())
+            {
+                stack.back().second++;
+                if (!visited[succs[next]])
+                {
+                    visited[succs[next]] = true;
+                    stack.emplace_back(succs[next], 0);
+                }
+                continue;
+            }
+            post_order.push_back(block);
+            stack.pop_back();
+        }
+        m_Order.assign(post_order.rbegin(), post_order.rend());
+        for (uint32_t i = 0; i < m_Order.size(); i++)
+            m_Blocks[m_Order[i]].order = i;
+    }
+
+    void ControlFlowGraph::BuildDominatorTree()
+    {
+        // Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm":
+        // iterate idom(b) = common dominator of the processed preds of b
+        // over reverse post-order until nothing changes
+        m_Blocks[0].idom = 0;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t i = 1; i < m_Order.size(); i++)
+            {
+                auto& block = m_Blocks[m_Order[i]];
+                auto idom = NONE;
+                for (auto pred : Preds(m_Order[i]))
+                {
+                    if (m_Blocks[pred].idom == NONE) continue;
+                    idom = idom == NONE ? pred : Intersect(pred, idom);
+                }
+                if (block.idom != idom)
+                {
+                    block.idom = idom;
+                    changed = true;
+                }
+            }
+        }
+        // children are listed in reverse post-order
+        m_DominatedOffsets.assign(m_Blocks.size() + 1, 0);
+        for (size_t i = 1; i < m_Order.size(); i++)
+            m_DominatedOffsets[m_Blocks[m_Order[i]].idom]++;
+        m_Dominated.resize(CountsToOffsets(m_DominatedOffsets));
+        std::vector<uint32_t> filled(m_DominatedOffsets.begin(), m_DominatedOffsets.end() - 1);
+        for (size_t i = 1; i < m_Order.size(); i++)
+            m_Dominated[filled[m_Blocks[m_Order[i]].idom]++] = m_Order[i];
+        // number the tree in preorder so that dominance is an interval test
+        uint32_t counter = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> stack{ { 0, 0 } };
+        m_Blocks[0].dom_enter = counter++;
+        while (!stack.empty())
+        {
+            auto [block, next] = stack.back();
+            auto dominated = Dominated(block);
+            if (next < dominated.size())
+            {
+                stack.back().second++;
+                m_Blocks[dominated[next]].dom_enter = counter++;
+                stack.emplace_back(dominated[next], 0);
+                continue;
+            }
+            m_Blocks[block].dom_exit = counter - 1;
+            stack.pop_back();
+        }
+    }
+
+    uint32_t ControlFlowGraph::Intersect(uint32_t a, uint32_t b) const
+    {
+        while (a != b)
+        {
+            while (m_Blocks[a].order > m_Blocks[b].order) a = m_Blocks[a].idom;
+            while (m_Blocks[b].order > m_Blocks[a].order) b = m_Blocks[b].idom;
+        }
+        return a;
+    }
+
+    void ControlFlowGraph::FindLoops()
+    {
+        // Headers are visited in post-order, so inner loops are found before
+        // the loops around them. A loop's body is collected by walking back
+        // from its back edges; a block already in an inner loop stands for
+        // that whole loop, which gets nested in the new one and is skipped
+        // by continuing from its header.
+        std::vector<uint32_t> worklist;
+        for (auto it = m_Order.rbegin(); it != m_Order.rend(); it++)
+        {
+            auto header = *it;
+            for (auto pred : Preds(header))
+            {
+                if (IsReachable(pred) && Dominates(header, pred))
+                    worklist.push_back(pred);
+            }
+            if (worklist.empty()) continue;
+            auto loop = static_cast<uint32_t>(m_Loops.size());
+            m_Loops.push_back({ header, NONE });
+            m_Blocks[header].loop = loop;
+            while (!worklist.empty())
+            {
+                auto block = worklist.back();
+                worklist.pop_back();
+                auto inner = m_Blocks[block].loop;
+                if (inner == NONE)
+                {
+                    m_Blocks[block].loop = loop;
+                }
+                else
+                {
+                    while (m_Loops[inner].parent != NONE) inner = m_Loops[inner].parent;
+                    if (inner == loop) continue;
+                    m_Loops[inner].parent = loop;
+                    block = m_Loops[inner].header;
+                }
+                // entries into the loop that bypass the header cannot come
+                // from structured code; they are left out of the body
+                for (auto pred : Preds(block))
+                {
+                    if (IsReachable(pred) && Dominates(header, pred))
+                        worklist.push_back(pred);
+                }
+            }
+        }
+        // parents are found after their children, so they have higher numbers
+        for (auto i = m_Loops.size(); i-- > 0;)
+        {
+            if (m_Loops[i].parent != NONE)
+                m_Loops[i].depth = m_Loops[m_Loops[i].parent].depth + 1;
+        }
+    }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "types.hpp"
+#include "utility/arena.hpp"
+
+namespace TAC
+{
+    // A run of statements that is only entered at its first statement and
+    // only left after its last one. Blocks are numbered in statement order,
+    // the entry block is block 0.
+    struct BasicBlock
+    {
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        // statements [begin, end) of the function
+        uint32_t begin = 0, end = 0;
+        // position in reverse post-order, NONE for unreachable blocks
+        uint32_t order = NONE;
+        // immediate dominator, the entry block is its own
+        uint32_t idom = NONE;
+        // preorder number of the block in the dominator tree and the
+        // highest number in its subtree
+        uint32_t dom_enter = 0, dom_exit = 0;
+        // innermost loop the block belongs to
+        uint32_t loop = NONE;
+    };
+    // A natural loop: its header and every block that reaches one of its
+    // back edges without passing through the header.
+    struct Loop
+    {
+        uint32_t header;
+        // enclosing loop, NONE for outermost loops
+        uint32_t parent;
+        // 1 for outermost loops
+        uint32_t depth = 1;
+    };
+    // Control flow of one TAC function: basic blocks linked by jumps and
+    // fall-through, their reverse post-order, the dominator tree and the
+    // loop nest. The graph is computed once, on construction, and goes stale
+    // when the function is changed. Edges are kept in flat tables rather
+    // than per block, so that building a graph allocates a handful of
+    // arrays whatever the number of blocks.
+    class ControlFlowGraph
+    {
+    public:
+        static constexpr uint32_t NONE = BasicBlock::NONE;
+
+        explicit ControlFlowGraph(const Function& function);
+
+        const Function& GetFunction() const { return m_Function; }
+        const std::vector<BasicBlock>& Blocks() const { return m_Blocks; }
+        const BasicBlock& Block(uint32_t block) const { return m_Blocks[block]; }
+        ArenaArray<const uint32_t> Preds(uint32_t block) const { return Slice(m_Preds, m_PredOffsets, block); }
+        ArenaArray<const uint32_t> Succs(uint32_t block) const { return Slice(m_Succs, m_SuccOffsets, block); }
+        // children in the dominator tree
+        ArenaArray<const uint32_t> Dominated(uint32_t block) const { return Slice(m_Dominated, m_DominatedOffsets, block); }
+        // reachable blocks, every block after its dominators and all of its
+        // predecessors that are not back edges
+        const std::vector<uint32_t>& ReversePostOrder() const { return m_Order; }
+        // loops are numbered inner before outer
+        const std::vector<Loop>& Loops() const { return m_Loops; }
+
+        uint32_t BlockOf(Operand label) const { return m_LabelBlocks[label.id()]; }
+        bool IsReachable(uint32_t block) const { return m_Blocks[block].order != NONE; }
+        // whether every path from the entry to b passes through a; both
+        // blocks have to be reachable
+        bool Dominates(uint32_t a, uint32_t b) const
+        {
+            return m_Blocks[a].dom_enter <= m_Blocks[b].dom_enter && m_Blocks[b].dom_enter <= m_Blocks[a].dom_exit;
+        }
+        bool InLoop(uint32_t block, uint32_t loop) const;
+        uint32_t LoopDepth(uint32_t block) const
+        {
+            return m_Blocks[block].loop == NONE ? 0 : m_Loops[m_Blocks[block].loop].depth;
+        }
+
+        void Print(std::ostream& out) const;
+
+    private:
+        const Function& m_Function;
+        std::vector<BasicBlock> m_Blocks;
+        std::vector<uint32_t> m_Order;
+        std::vector<uint32_t> m_LabelBlocks;
+        std::vector<Loop> m_Loops;
+        // the preds of block b are m_Preds[m_PredOffsets[b], m_PredOffsets[b + 1]),
+        // likewise for succs and dominated blocks
+        std::vector<uint32_t> m_PredOffsets, m_Preds;
+        std::vector<uint32_t> m_SuccOffsets, m_Succs;
+        std::vector<uint32_t> m_DominatedOffsets, m_Dominated;
+
+        static ArenaArray<const uint32_t> Slice(const std::vector<uint32_t>& table, const std::vector<uint32_t>& offsets, uint32_t block)
+        {
+            return { table.data() + offsets[block], offsets[block + 1] - offsets[block] };
+        }
+        // turns counts per block into offsets and returns the total
+        static uint32_t CountsToOffsets(std::vector<uint32_t>& offsets);
+
+        void SplitBlocks();
+        void LinkBlocks();
+        void OrderBlocks();
+        void BuildDominatorTree();
+        uint32_t Intersect(uint32_t a, uint32_t b) const;
+        void FindLoops();
+    };
+};
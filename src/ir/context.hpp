@@ -1,30 +1,39 @@
 #pragma once
 
-#include <stack>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "symbol.hpp"
 
 struct Scope
 {
-    std::unordered_map<std::string, VarSymbol::Ref> symbols; 
-    std::string start_label, end_label;
-
-    Scope() : symbols()
+    // ids of the labels continue and break jump to
+    uint32_t start_label = 0, end_label = 0;
+    // length of the undo log when the scope was opened
+    size_t undo_mark = 0;
+    // innermost scope, this one included, that break / continue jump out of
+    size_t loop = SIZE_MAX;
+
+    Scope()
     {
     }
 
-    Scope(const std::string& start_label, const std::string& end_label) : symbols(), start_label(start_label), end_label(end_label)
+    Scope(uint32_t start_label, uint32_t end_label) : start_label(start_label), end_label(end_label)
     {
     }
 };
 
+// Scoped symbol table. Names are dense interner ids, so the visible binding
+// of every name lives in a flat array indexed by id; declaring a variable
+// saves the binding it shadows in an undo log, and closing a scope replays
+// the log back to where the scope started. Lookup, declaration and the
+// redeclaration check are O(1) regardless of nesting depth.
 class VarContext
 {
 public:
-    VarContext()
+    VarContext(const StringInterner& names) : m_Names(names)
     {
         // global scope
         push_scope();
@@ -32,46 +41,45 @@ public:
 
     void push_scope()
     {
-        scope_stack.emplace_back(Scope());
+        auto& scope = scope_stack.emplace_back();
+        scope.undo_mark = m_Undo.size();
+        scope.loop = scope_stack.size() > 1 ? scope_stack[scope_stack.size() - 2].loop : SIZE_MAX;
     }
 
-    void push_scope(const std::string& start_label, const std::string& end_label)
+    void push_scope(uint32_t start_label, uint32_t end_label)
     {
-        scope_stack.emplace_back(Scope(start_label, end_label));
+        auto& scope = scope_stack.emplace_back(start_label, end_label);
+        scope.undo_mark = m_Undo.size();
+        scope.loop = scope_stack.size() - 1;
     }
 
     void pop_scope()
     {
         if (scope_stack.size() < 1)
             throw std::runtime_error("error: Cannot remove stack from empty context");
+        for (size_t mark = scope_stack.back().undo_mark; m_Undo.size() > mark; m_Undo.pop_back())
+            m_Bindings[m_Undo.back().name] = m_Undo.back().shadowed;
         scope_stack.pop_back();
     }
 
-    void add_var(const std::string& var_name, VarSymbol::Ref var_symbol)
+    void add_var(StringId var_name, VarSymbol::Ref var_symbol)
     {
         // check if var already exists in top scope
-        auto scope = get_scope();
-        if (scope.symbols.find(var_name) != scope.symbols.end())
-            throw std::runtime_error("error: Redeclaration of identifier '" + var_name + "'"); 
-        else get_scope().symbols[var_name] = var_symbol;
+        if (current_scope_has_var(var_name))
+            throw std::runtime_error("error: Redeclaration of identifier '" + std::string(m_Names.Lookup(var_name)) + "'"); 
+        if (var_name >= m_Bindings.size())
+            m_Bindings.resize(var_name + 1);
+        auto& binding = m_Bindings[var_name];
+        m_Undo.push_back({ var_name, binding });
+        binding = { var_symbol, scope_stack.size() - 1 };
     }
 
-    VarSymbol::Ref get_var(const std::string& var_name)
+    VarSymbol::Ref get_var(StringId var_name) const
     {
-        // traverse vector in reverse
-        for (size_t i = scope_stack.size() - 1; i < scope_stack.size(); i--)
-        {
-            auto scope = scope_stack[i];
-            if (scope.symbols.find(var_name) != scope.symbols.end())
-                return scope.symbols[var_name]; 
-        }
+        if (var_name < m_Bindings.size() && m_Bindings[var_name].symbol)
+            return m_Bindings[var_name].symbol;
         // no variable found
-        throw std::runtime_error("error: Undeclared identifier '" + var_name + "'"); 
-    }
-
-    const VarSymbol::Ref get_var(const std::string& var_name) const
-    {
-        return get_var(var_name);
+        throw std::runtime_error("error: Undeclared identifier '" + std::string(m_Names.Lookup(var_name)) + "'"); 
     }
 
     Scope& get_scope()
@@ -81,53 +89,55 @@ public:
         return scope_stack[scope_stack.size() - 1]; 
     }
 
-    const Scope& get_scope() const 
+    const Scope& get_scope() const
     {
         if (scope_stack.size() < 1)
             throw std::runtime_error("error: Cannot get scope from empty context");
         return scope_stack[scope_stack.size() - 1]; 
     }
 
-    const std::string& get_start_label() const
+    uint32_t get_start_label() const
     {
-        for (size_t i = scope_stack.size() - 1; i < scope_stack.size(); i--)
-        {
-            auto& scope = scope_stack[i]; 
-            if (!scope.start_label.empty())
-                return scope.start_label;
-        }
-        throw std::runtime_error("error: continue statement not within loop");
+        if (scope_stack.empty() || scope_stack.back().loop == SIZE_MAX)
+            throw std::runtime_error("error: continue statement not within loop");
+        return scope_stack[scope_stack.back().loop].start_label;
     }
 
-    const std::string& get_end_label() const
+    uint32_t get_end_label() const
     {
-        for (size_t i = scope_stack.size() - 1; i < scope_stack.size(); i--)
-        {
-            auto& scope = scope_stack[i]; 
-            if (!scope.end_label.empty())
-                return scope.end_label;
-        }
-        throw std::runtime_error("error: break statement not within loop or switch");
+        if (scope_stack.empty() || scope_stack.back().loop == SIZE_MAX)
+            throw std::runtime_error("error: break statement not within loop or switch");
+        return scope_stack[scope_stack.back().loop].end_label;
     }
 
-    bool any_scope_has_var(const std::string& var_name) const
+    bool any_scope_has_var(StringId var_name) const
     {
-        // traverse vector in reverse
-        for (size_t i = scope_stack.size() - 1; i >= 0; i--)
-        {
-            auto scope = scope_stack[i];
-            if (scope.symbols.find(var_name) != scope.symbols.end())
-                return true;
-        }
-        return false;
+        return var_name < m_Bindings.size() && m_Bindings[var_name].symbol;
     }
 
-    bool current_scope_has_var(const std::string& var_name) const
+    bool current_scope_has_var(StringId var_name) const
     {
-        auto scope = get_scope();
-        return scope.symbols.find(var_name) != scope.symbols.end(); 
+        return any_scope_has_var(var_name) && m_Bindings[var_name].depth == scope_stack.size() - 1;
     }
-    
+
 private:
+    // the declaration a name currently resolves to
+    struct Binding
+    {
+        VarSymbol::Ref symbol = nullptr;
+        size_t depth = 0;
+    };
+
+    // a declaration to take back when its scope closes
+    struct Shadow
+    {
+        StringId name;
+        Binding shadowed;
+    };
+
+    // spellings for diagnostics
+    const StringInterner& m_Names;
     std::vector<Scope> scope_stack;
-};
\ No newline at end of file
+    std::vector<Binding> m_Bindings;
+    std::vector<Shadow> m_Undo;
+};
@@ -78,10 +78,11 @@ namespace TAC
                 return OpCode::LSH;
             case AssignmentOpType::RightShift:
                 return OpCode::RSH;
+            // |= and &= are bitwise despite the enum names
             case AssignmentOpType::LogicalOr:
-                return OpCode::BOOL_OR;
+                return OpCode::OR;
             case AssignmentOpType::LogicalAnd:
-                return OpCode::BOOL_AND;
+                return OpCode::AND;
             case AssignmentOpType::LogicalXOR:
                 return OpCode::XOR;
         }
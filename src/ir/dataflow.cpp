@@ -0,0 +1,83 @@
+#include "dataflow.hpp"
+
+#include <algorithm>
+
+namespace TAC
+{
+    BitVectorProblem::BitVectorProblem(const ControlFlowGraph& graph, uint32_t bits) :
+        m_Graph(graph),
+        m_In(static_cast<uint32_t>(graph.Blocks().size()), bits),
+        m_Out(static_cast<uint32_t>(graph.Blocks().size()), bits)
+    {
+    }
+
+    void BitVectorProblem::Solve()
+    {
+        auto count = static_cast<uint32_t>(m_Graph.Blocks().size());
+        std::vector<uint32_t> order = m_Graph.ReversePostOrder();
+        std::reverse(order.begin(), order.end());
+        for (uint32_t block = count; block-- > 0;)
+        {
+            if (!m_Graph.IsReachable(block)) order.push_back(block);
+        }
+        std::vector<uint32_t> position(count);
+        for (uint32_t i = 0; i < count; i++)
+            position[order[i]] = i;
+        // effects grouped by block, in the order they were given
+        std::vector<uint32_t> offsets(count + 1, 0);
+        for (const auto& effect : m_Effects)
+            offsets[effect.block + 1]++;
+        for (uint32_t block = 0; block < count; block++)
+            offsets[block + 1] += offsets[block];
+        std::vector<Effect> effects(m_Effects.size());
+        {
+            std::vector<uint32_t> filled(offsets.begin(), offsets.end() - 1);
+            for (const auto& effect : m_Effects)
+                effects[filled[effect.block]++] = effect;
+        }
+
+        auto stride = m_In.Stride();
+        std::vector<uint64_t> result(stride);
+        // pending blocks by their position in the visiting order
+        std::vector<bool> pending(count, true);
+        auto remaining = count;
+        while (remaining > 0)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (!pending[i]) continue;
+                pending[i] = false;
+                remaining--;
+                auto block = order[i];
+                auto succs = m_Graph.Succs(block);
+                auto* out = m_Out.Row(block);
+                std::fill(out, out + stride, 0);
+                for (auto succ : succs)
+                {
+                    const auto* in = m_In.Row(succ);
+                    for (uint32_t w = 0; w < stride; w++)
+                        out[w] |= in[w];
+                }
+                // kills first, so that a bit both killed and generated is set
+                std::copy(out, out + stride, result.begin());
+                for (auto e = offsets[block]; e < offsets[block + 1]; e++)
+                {
+                    if (!effects[e].gen) result[effects[e].bit / 64] &= ~(uint64_t(1) << (effects[e].bit % 64));
+                }
+                for (auto e = offsets[block]; e < offsets[block + 1]; e++)
+                {
+                    if (effects[e].gen) result[effects[e].bit / 64] |= uint64_t(1) << (effects[e].bit % 64);
+                }
+                auto* in = m_In.Row(block);
+                if (std::equal(result.begin(), result.end(), in)) continue;
+                std::copy(result.begin(), result.end(), in);
+                for (auto pred : m_Graph.Preds(block))
+                {
+                    if (pending[position[pred]]) continue;
+                    pending[position[pred]] = true;
+                    remaining++;
+                }
+            }
+        }
+    }
+};
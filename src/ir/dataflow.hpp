@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cfg.hpp"
+
+namespace TAC
+{
+    // Rows of dense bit-vectors of one size, stored back to back so that a
+    // whole table is a single allocation. Bits past the size stay clear.
+    class BitTable
+    {
+    public:
+        BitTable() = default;
+        BitTable(uint32_t rows, uint32_t bits) :
+            m_Bits(bits), m_Stride((bits + 63) / 64), m_Words(static_cast<size_t>(rows) * m_Stride, 0)
+        {
+        }
+
+        uint32_t Bits() const { return m_Bits; }
+        // words per row
+        uint32_t Stride() const { return m_Stride; }
+        uint64_t* Row(uint32_t row) { return m_Words.data() + static_cast<size_t>(row) * m_Stride; }
+        const uint64_t* Row(uint32_t row) const { return m_Words.data() + static_cast<size_t>(row) * m_Stride; }
+
+        bool Test(uint32_t row, uint32_t bit) const { return Row(row)[bit / 64] >> (bit % 64) & 1; }
+        void Set(uint32_t row, uint32_t bit) { Row(row)[bit / 64] |= uint64_t(1) << (bit % 64); }
+        void Reset(uint32_t row, uint32_t bit) { Row(row)[bit / 64] &= ~(uint64_t(1) << (bit % 64)); }
+
+        // calls f with every set bit of the row, in increasing order
+        template <typename F>
+        void ForEach(uint32_t row, F f) const
+        {
+            const auto* words = Row(row);
+            for (uint32_t i = 0; i < m_Stride; i++)
+            {
+                for (auto word = words[i]; word != 0; word &= word - 1)
+                    f(i * 64 + static_cast<uint32_t>(__builtin_ctzll(word)));
+            }
+        }
+
+    private:
+        uint32_t m_Bits = 0;
+        uint32_t m_Stride = 0;
+        std::vector<uint64_t> m_Words;
+    };
+
+    // Iterative solver for backward bit-vector dataflow problems over a
+    // control flow graph, liveness being the one the compiler has. Every
+    // block turns the set at its end into gen | (set & ~kill) at its start,
+    // and the set at a block's end is the union of those at the start of its
+    // successors; blocks without successors start from the empty set. The
+    // sets at block boundaries are dense; gen and kill only name the few
+    // bits a block touches, so they are kept as lists.
+    //
+    // Blocks are visited in post-order, unreachable blocks last, and a block
+    // is only visited again when the set at the start of a successor has
+    // changed. Most problems settle in a pass per loop nesting level plus
+    // one.
+    class BitVectorProblem
+    {
+    public:
+        BitVectorProblem(const ControlFlowGraph& graph, uint32_t bits);
+
+        // the transfer of each block, given before solving
+        void Gen(uint32_t block, uint32_t bit) { m_Effects.push_back({ block, bit, true }); }
+        void Kill(uint32_t block, uint32_t bit) { m_Effects.push_back({ block, bit, false }); }
+
+        void Solve();
+
+        // the sets at the start and at the end of every block
+        const BitTable& In() const { return m_In; }
+        const BitTable& Out() const { return m_Out; }
+
+    private:
+        struct Effect
+        {
+            uint32_t block;
+            uint32_t bit;
+            bool gen;
+        };
+
+        const ControlFlowGraph& m_Graph;
+        std::vector<Effect> m_Effects;
+        BitTable m_In, m_Out;
+    };
+};
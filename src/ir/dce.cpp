@@ -0,0 +1,66 @@
+#include "dce.hpp"
+
+#include <vector>
+
+#include "cfg.hpp"
+#include "liveness.hpp"
+
+namespace TAC
+{
+    size_t eliminate_dead_code(Function& function)
+    {
+        size_t removed = 0;
+        auto& statements = function.statements;
+        std::vector<bool> dead, live;
+        // values set in live since the start of the block
+        std::vector<uint32_t> touched;
+        while (true)
+        {
+            ControlFlowGraph graph{ function };
+            Liveness liveness{ graph };
+            dead.assign(statements.size(), false);
+            live.assign(liveness.Values(), false);
+            size_t found = 0;
+            auto read = [&](Operand operand) {
+                auto index = liveness.Index(operand);
+                if (index == Liveness::NONE) return;
+                live[index] = true;
+                touched.push_back(index);
+            };
+            for (uint32_t block = 0; block < graph.Blocks().size(); block++)
+            {
+                for (auto index : touched) live[index] = false;
+                touched.clear();
+                liveness.ForEachLiveOut(block, read);
+                const auto& info = graph.Block(block);
+                for (auto i = info.end; i-- > info.begin;)
+                {
+                    const auto& statement = statements[i];
+                    if (assigns_value(statement))
+                    {
+                        auto index = liveness.Index(statement.dst);
+                        if (!live[index])
+                        {
+                            dead[i] = true;
+                            found++;
+                            continue;
+                        }
+                        live[index] = false;
+                    }
+                    for_each_use(statement, read);
+                }
+            }
+            if (found == 0) return removed;
+            removed += found;
+            size_t kept = 0;
+            for (size_t i = 0; i < statements.size(); i++)
+            {
+                if (dead[i]) continue;
+                if (statements[i].type == StatementType::Label)
+                    function.label_positions[statements[i].dst.id()] = static_cast<uint32_t>(kept);
+                statements[kept++] = statements[i];
+            }
+            statements.resize(kept);
+        }
+    }
+};
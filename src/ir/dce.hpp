@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+#include "types.hpp"
+
+namespace TAC
+{
+    // Removes the statements assigning a variable or temp that no path reads
+    // afterwards. Values only read by removed statements die with them: those
+    // of the same block in the same backward walk, the others in another
+    // round over recomputed liveness. TAC has no side effects besides its
+    // assignments and jumps, so nothing else is kept alive. Returns how many
+    // statements were removed.
+    size_t eliminate_dead_code(Function& function);
+};
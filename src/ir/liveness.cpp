@@ -0,0 +1,113 @@
+#include "liveness.hpp"
+
+#include <algorithm>
+
+namespace TAC
+{
+    Liveness::Liveness(const ControlFlowGraph& graph) :
+        m_Graph(graph),
+        m_Problem(graph, AssignBits())
+    {
+        // a block generates the values it reads before assigning them and
+        // kills the ones it assigns
+        const auto& statements = graph.GetFunction().statements;
+        // the last block that generated or killed each bit, and how
+        std::vector<uint32_t> seen_in(m_Operands.size(), NONE);
+        std::vector<bool> killed(m_Operands.size(), false);
+        for (uint32_t block = 0; block < graph.Blocks().size(); block++)
+        {
+            const auto& info = graph.Block(block);
+            for (auto i = info.begin; i < info.end; i++)
+            {
+                for_each_use(statements[i], [&](Operand operand) {
+                    auto index = Index(operand);
+                    if (index == NONE || m_Bits[index] == NONE || seen_in[m_Bits[index]] == block) return;
+                    seen_in[m_Bits[index]] = block;
+                    killed[m_Bits[index]] = false;
+                    m_Problem.Gen(block, m_Bits[index]);
+                });
+                if (!assigns_value(statements[i])) continue;
+                auto bit = m_Bits[Index(statements[i].dst)];
+                if (bit == NONE || (seen_in[bit] == block && killed[bit])) continue;
+                seen_in[bit] = block;
+                killed[bit] = true;
+                m_Problem.Kill(block, bit);
+            }
+        }
+        m_Problem.Solve();
+    }
+
+    std::vector<Liveness::Range> Liveness::TempRanges() const
+    {
+        // Inside a block a temp is needed from where it is assigned to where
+        // it is read. It also covers the start of the blocks it is live into
+        // and the end of the blocks it is live out of, which stretches it
+        // over the loops it is live around.
+        const auto& function = m_Graph.GetFunction();
+        std::vector<Range> ranges(function.temp_count);
+        auto cover = [&ranges](Operand operand, uint32_t position) {
+            if (operand.type != OperandType::Temp) return;
+            auto& range = ranges[operand.id()];
+            range.start = std::min(range.start, position);
+            range.end = std::max(range.end, position);
+        };
+        for (uint32_t block = 0; block < m_Graph.Blocks().size(); block++)
+        {
+            const auto& info = m_Graph.Block(block);
+            if (info.begin == info.end) continue;
+            m_Problem.In().ForEach(block, [&](uint32_t bit) { cover(m_Operands[bit], info.begin); });
+            m_Problem.Out().ForEach(block, [&](uint32_t bit) { cover(m_Operands[bit], info.end - 1); });
+            for (auto i = info.begin; i < info.end; i++)
+            {
+                const auto& statement = function.statements[i];
+                for_each_use(statement, [&](Operand operand) { cover(operand, i); });
+                if (assigns_value(statement)) cover(statement.dst, i);
+            }
+        }
+        return ranges;
+    }
+
+    uint32_t Liveness::Index(Operand operand) const
+    {
+        switch (operand.type)
+        {
+            case OperandType::Variable:
+                return operand.id();
+            case OperandType::Temp:
+                return static_cast<uint32_t>(m_Graph.GetFunction().variables.size()) + operand.id();
+            default:
+                return NONE;
+        }
+    }
+
+    bool Liveness::IsLive(const BitTable& table, uint32_t block, Operand operand) const
+    {
+        auto index = Index(operand);
+        return index != NONE && m_Bits[index] != NONE && table.Test(block, m_Bits[index]);
+    }
+
+    uint32_t Liveness::AssignBits()
+    {
+        // runs before the problem is built, to size it
+        const auto& function = m_Graph.GetFunction();
+        m_Bits.assign(function.variables.size() + function.temp_count, NONE);
+        // the last block that assigned each value
+        std::vector<uint32_t> assigned_in(m_Bits.size(), NONE);
+        for (uint32_t block = 0; block < m_Graph.Blocks().size(); block++)
+        {
+            const auto& info = m_Graph.Block(block);
+            for (auto i = info.begin; i < info.end; i++)
+            {
+                const auto& statement = function.statements[i];
+                for_each_use(statement, [&](Operand operand) {
+                    auto index = Index(operand);
+                    if (index == NONE || assigned_in[index] == block || m_Bits[index] != NONE) return;
+                    m_Bits[index] = static_cast<uint32_t>(m_Operands.size());
+                    m_Operands.push_back(operand);
+                });
+                if (assigns_value(statement)) assigned_in[Index(statement.dst)] = block;
+            }
+        }
+        return static_cast<uint32_t>(m_Operands.size());
+    }
+};
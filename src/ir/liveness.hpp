@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cfg.hpp"
+#include "dataflow.hpp"
+#include "types.hpp"
+
+namespace TAC
+{
+    // Live variables and temps of a function: a value is live at a point if
+    // some path from there reads it before assigning it. Only values that a
+    // block reads before assigning them can be live across a block boundary,
+    // so only those get a bit in the per-block sets; every other value lives
+    // and dies inside one block.
+    class Liveness
+    {
+    public:
+        static constexpr uint32_t NONE = ControlFlowGraph::NONE;
+
+        // statements during which a value has to be kept, from the first one
+        // that assigns it or that it is live across to the last one that reads
+        // it or that it is live across
+        struct Range
+        {
+            uint32_t start = NONE;
+            uint32_t end = 0;
+
+            bool empty() const { return start == NONE; }
+        };
+
+        explicit Liveness(const ControlFlowGraph& graph);
+
+        const ControlFlowGraph& Graph() const { return m_Graph; }
+        // values that get a bit in the per-block sets
+        uint32_t Tracked() const { return static_cast<uint32_t>(m_Operands.size()); }
+        // variables and then temps numbered densely, for clients that keep
+        // sets of their own; Index is NONE for constants
+        uint32_t Values() const { return static_cast<uint32_t>(m_Bits.size()); }
+        uint32_t Index(Operand operand) const;
+
+        bool LiveIn(uint32_t block, Operand operand) const { return IsLive(m_Problem.In(), block, operand); }
+        bool LiveOut(uint32_t block, Operand operand) const { return IsLive(m_Problem.Out(), block, operand); }
+        // calls f with every value live at the end of the block
+        template <typename F>
+        void ForEachLiveOut(uint32_t block, F f) const
+        {
+            m_Problem.Out().ForEach(block, [&](uint32_t bit) { f(m_Operands[bit]); });
+        }
+
+        // the range of every temp in statement order, holes and loops
+        // included; temps no statement mentions get an empty range
+        std::vector<Range> TempRanges() const;
+
+    private:
+        const ControlFlowGraph& m_Graph;
+        // bit of every variable and then every temp, NONE for values local
+        // to a block
+        std::vector<uint32_t> m_Bits;
+        // value of every bit
+        std::vector<Operand> m_Operands;
+        BitVectorProblem m_Problem;
+
+        bool IsLive(const BitTable& table, uint32_t block, Operand operand) const;
+        uint32_t AssignBits();
+    };
+};
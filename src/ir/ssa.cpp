@@ -0,0 +1,597 @@
+#include "ssa.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "liveness.hpp"
+
+namespace TAC
+{
+    namespace
+    {
+        bool Same(Operand a, Operand b)
+        {
+            return a.type == b.type && a.value == b.value;
+        }
+
+        bool AssignsVariable(const Statement& statement)
+        {
+            return assigns_value(statement) && statement.dst.type == OperandType::Variable;
+        }
+
+        // Orders a parallel copy so that no copy overwrites a variable another
+        // one still has to read. Copies whose destination is read by none of
+        // the others go first; when none is left, every remaining copy is on
+        // a cycle, which the scratch variable breaks open. A broken cycle
+        // unwinds completely before the next one needs the scratch.
+        // Returns whether the scratch was used.
+        bool Sequentialize(std::vector<Statement>& copies, std::vector<Statement>& out, Operand scratch)
+        {
+            bool used_scratch = false;
+            while (!copies.empty())
+            {
+                bool progress = false;
+                for (size_t i = 0; i < copies.size();)
+                {
+                    auto dst = copies[i].dst;
+                    bool read = std::any_of(copies.begin(), copies.end(),
+                        [dst](const Statement& copy) { return Same(copy.rhs, dst); });
+                    if (read)
+                    {
+                        i++;
+                        continue;
+                    }
+                    out.push_back(copies[i]);
+                    copies.erase(copies.begin() + i);
+                    progress = true;
+                }
+                if (progress) continue;
+                auto saved = copies.front().dst;
+                assert(std::none_of(copies.begin(), copies.end(), [scratch](const Statement& copy) { return Same(copy.rhs, scratch); }));
+                out.push_back(Statement::Assign(scratch, saved));
+                for (auto& copy : copies)
+                {
+                    if (Same(copy.rhs, saved)) copy.rhs = scratch;
+                }
+                used_scratch = true;
+            }
+            return used_scratch;
+        }
+    }
+
+    SSAForm::SSAForm(Function& function) : m_Function(function), m_Graph(function)
+    {
+        m_VariableCount = static_cast<uint32_t>(function.variables.size());
+        m_Origins.resize(m_VariableCount);
+        for (uint32_t i = 0; i < m_VariableCount; i++) m_Origins[i] = i;
+        m_Numbers.assign(m_VariableCount, 0);
+        m_Definitions.assign(m_VariableCount, Site());
+        m_Phis.resize(m_Graph.Blocks().size());
+        PlacePhis();
+        Rename();
+        LinkUses();
+    }
+
+    void SSAForm::PlacePhis()
+    {
+        const auto& blocks = m_Graph.Blocks();
+        auto& statements = m_Function.statements;
+        Liveness liveness{ m_Graph };
+        // the blocks assigning each variable
+        std::vector<uint32_t> assigned_in(m_VariableCount, NONE);
+        std::vector<std::pair<uint32_t, uint32_t>> assignments;
+        for (auto block : m_Graph.ReversePostOrder())
+        {
+            for (auto i = blocks[block].begin; i < blocks[block].end; i++)
+            {
+                if (AssignsVariable(statements[i]) && assigned_in[statements[i].dst.id()] != block)
+                {
+                    assigned_in[statements[i].dst.id()] = block;
+                    assignments.emplace_back(statements[i].dst.id(), block);
+                }
+            }
+        }
+        std::sort(assignments.begin(), assignments.end());
+        // dominance frontiers: a join point is in the frontier of each block
+        // on the dominator tree path from its preds up to its idom
+        std::vector<std::vector<uint32_t>> frontiers(blocks.size());
+        for (auto block : m_Graph.ReversePostOrder())
+        {
+            if (m_Graph.Preds(block).size() < 2) continue;
+            for (auto pred : m_Graph.Preds(block))
+            {
+                if (!m_Graph.IsReachable(pred)) continue;
+                for (auto runner = pred; runner != blocks[block].idom; runner = blocks[runner].idom)
+                {
+                    if (!frontiers[runner].empty() && frontiers[runner].back() == block) break;
+                    frontiers[runner].push_back(block);
+                }
+            }
+        }
+        // per variable, the blocks given a phi and the blocks queued, each
+        // marked with the variable so the marks need no clearing; a join
+        // only gets a phi if the variable is live into it
+        std::vector<uint32_t> has_phi(blocks.size(), NONE), queued(blocks.size(), NONE);
+        std::vector<uint32_t> worklist;
+        for (size_t first = 0; first < assignments.size();)
+        {
+            auto variable = assignments[first].first;
+            auto last = first;
+            while (last < assignments.size() && assignments[last].first == variable) last++;
+            for (auto i = first; i < last; i++)
+            {
+                queued[assignments[i].second] = variable;
+                worklist.push_back(assignments[i].second);
+            }
+            while (!worklist.empty())
+            {
+                auto block = worklist.back();
+                worklist.pop_back();
+                for (auto join : frontiers[block])
+                {
+                    if (has_phi[join] == variable || !liveness.LiveIn(join, Operand::Variable(variable))) continue;
+                    has_phi[join] = variable;
+                    m_Phis[join].push_back({ Operand::Variable(variable),
+                        std::vector<Operand>(m_Graph.Preds(join).size(), Operand::Variable(variable)) });
+                    if (queued[join] == variable) continue;
+                    queued[join] = variable;
+                    worklist.push_back(join);
+                }
+            }
+            first = last;
+        }
+    }
+
+    void SSAForm::Rename()
+    {
+        // Walks the dominator tree with an explicit stack. current holds the
+        // version of each variable reaching the point being renamed; the
+        // trail records what it held before, to restore on leaving a block.
+        std::vector<uint32_t> current(m_Origins);
+        std::vector<std::pair<uint32_t, uint32_t>> trail;
+        struct Frame
+        {
+            uint32_t block;
+            uint32_t next;
+            size_t mark;
+        };
+        const auto& blocks = m_Graph.Blocks();
+        std::vector<Frame> stack{ { 0, 0, trail.size() } };
+        RenameBlock(0, current, trail);
+        while (!stack.empty())
+        {
+            auto& frame = stack.back();
+            auto dominated = m_Graph.Dominated(frame.block);
+            if (frame.next < dominated.size())
+            {
+                auto child = dominated[frame.next++];
+                stack.push_back({ child, 0, trail.size() });
+                RenameBlock(child, current, trail);
+                continue;
+            }
+            for (; trail.size() > frame.mark; trail.pop_back())
+                current[trail.back().first] = trail.back().second;
+            stack.pop_back();
+        }
+        // unreachable blocks never run, their versions only have to be unique
+        for (uint32_t block = 0; block < blocks.size(); block++)
+        {
+            if (m_Graph.IsReachable(block)) continue;
+            RenameBlock(block, current, trail);
+            for (; !trail.empty(); trail.pop_back())
+                current[trail.back().first] = trail.back().second;
+        }
+    }
+
+    void SSAForm::RenameBlock(uint32_t block, std::vector<uint32_t>& current, std::vector<std::pair<uint32_t, uint32_t>>& trail)
+    {
+        auto define = [&](Operand& dst, Site site) {
+            auto variable = m_Origins[dst.id()];
+            auto version = NewVersion(variable, site);
+            trail.emplace_back(variable, current[variable]);
+            current[variable] = version;
+            dst = Operand::Variable(version);
+        };
+        auto& phis = m_Phis[block];
+        for (uint32_t i = 0; i < phis.size(); i++)
+            define(phis[i].dst, { block, i, true });
+        const auto& info = m_Graph.Block(block);
+        auto& statements = m_Function.statements;
+        for (auto i = info.begin; i < info.end; i++)
+        {
+            for_each_use(statements[i], [&](Operand& operand) {
+                if (operand.type == OperandType::Variable)
+                    operand = Operand::Variable(current[operand.id()]);
+            });
+            if (AssignsVariable(statements[i]))
+                define(statements[i].dst, { block, i, false });
+        }
+        for (auto succ : m_Graph.Succs(block))
+        {
+            auto preds = m_Graph.Preds(succ);
+            auto edge = std::find(preds.begin(), preds.end(), block) - preds.begin();
+            for (auto& phi : m_Phis[succ])
+                phi.args[edge] = Operand::Variable(current[m_Origins[phi.dst.id()]]);
+        }
+    }
+
+    uint32_t SSAForm::NewVersion(uint32_t variable, Site definition)
+    {
+        auto version = static_cast<uint32_t>(m_Function.variables.size());
+        auto copy = m_Function.variables[variable];
+        m_Function.variables.push_back(copy);
+        m_Origins.push_back(variable);
+        auto number = ++m_Numbers[variable];
+        m_Numbers.push_back(number);
+        m_Definitions.push_back(definition);
+        return version;
+    }
+
+    void SSAForm::LinkUses()
+    {
+        // counted first, then filled in, so all uses share one array
+        auto versions = m_Function.variables.size();
+        m_UseOffsets.assign(versions + 1, 0);
+        auto& statements = m_Function.statements;
+        const auto& blocks = m_Graph.Blocks();
+        auto visit = [&](auto&& use) {
+            for (uint32_t block = 0; block < blocks.size(); block++)
+            {
+                const auto& phis = m_Phis[block];
+                for (uint32_t i = 0; i < phis.size(); i++)
+                {
+                    for (auto arg : phis[i].args)
+                        use(arg, Site{ block, i, true });
+                }
+                for (auto i = blocks[block].begin; i < blocks[block].end; i++)
+                {
+                    for_each_use(statements[i], [&](Operand operand) {
+                        use(operand, Site{ block, i, false });
+                    });
+                }
+            }
+        };
+        visit([&](Operand operand, Site) {
+            if (operand.type == OperandType::Variable) m_UseOffsets[operand.id() + 1]++;
+        });
+        for (size_t i = 0; i < versions; i++)
+            m_UseOffsets[i + 1] += m_UseOffsets[i];
+        m_Uses.resize(m_UseOffsets[versions]);
+        std::vector<uint32_t> filled(m_UseOffsets.begin(), m_UseOffsets.end() - 1);
+        visit([&](Operand operand, Site site) {
+            if (operand.type == OperandType::Variable) m_Uses[filled[operand.id()]++] = site;
+        });
+    }
+
+    void SSAForm::Print(std::ostream& out, const StringInterner& names) const
+    {
+        auto format = [&](Operand operand) -> std::string {
+            switch (operand.type)
+            {
+                case OperandType::Constant:
+                    return std::to_string(operand.value);
+                case OperandType::Variable:
+                {
+                    std::string name{ names.Lookup(m_Function.variables[operand.id()].name) };
+                    if (operand.id() < m_VariableCount) return name;
+                    return name + "." + std::to_string(m_Numbers[operand.id()]);
+                }
+                case OperandType::Temp:
+                    return "t" + std::to_string(operand.id() + 1);
+                case OperandType::Label:
+                    return label_name(operand.id());
+                case OperandType::None:
+                    break;
+            }
+            return "";
+        };
+        const auto& blocks = m_Graph.Blocks();
+        for (uint32_t block = 0; block < blocks.size(); block++)
+        {
+            out << "B" << block << ":\n";
+            for (const auto& phi : m_Phis[block])
+            {
+                out << format(phi.dst) << " = phi(";
+                for (size_t i = 0; i < phi.args.size(); i++)
+                    out << (i == 0 ? "" : ", ") << format(phi.args[i]);
+                out << ")\n";
+            }
+            for (auto i = blocks[block].begin; i < blocks[block].end; i++)
+                print_statement(out, m_Function.statements[i], format);
+        }
+    }
+
+    size_t SSAForm::PropagateCopies()
+    {
+        // a copy's source is defined in a block that dominates it, which
+        // reverse post-order visits first, so chains of copies resolve in
+        // one pass
+        auto& statements = m_Function.statements;
+        std::vector<uint32_t> values(m_Function.variables.size());
+        for (uint32_t i = 0; i < values.size(); i++) values[i] = i;
+        size_t copies = 0;
+        for (auto block : m_Graph.ReversePostOrder())
+        {
+            const auto& info = m_Graph.Block(block);
+            for (auto i = info.begin; i < info.end; i++)
+            {
+                const auto& statement = statements[i];
+                if (statement.type != StatementType::Assign || statement.dst.type != OperandType::Variable ||
+                    statement.rhs.type != OperandType::Variable) continue;
+                values[statement.dst.id()] = values[statement.rhs.id()];
+                copies++;
+            }
+        }
+        if (copies == 0) return 0;
+        auto resolve = [&values](Operand& operand) {
+            if (operand.type == OperandType::Variable) operand = Operand::Variable(values[operand.id()]);
+        };
+        for (auto& statement : statements)
+            for_each_use(statement, resolve);
+        for (auto& phis : m_Phis)
+        {
+            for (auto& phi : phis)
+            {
+                for (auto& arg : phi.args) resolve(arg);
+            }
+        }
+        LinkUses();
+        return copies;
+    }
+
+    void SSAForm::Lower()
+    {
+        // copies to insert before a statement, ordered by position and then
+        // by the block they leave, so that the copies falling out of a block
+        // come before those of the block after it
+        struct Insertion
+        {
+            uint32_t position;
+            uint32_t block;
+            Statement copy;
+        };
+        // a jump to a join point that gets its own block for the copies
+        struct SplitEdge
+        {
+            uint32_t jump;
+            Operand label;
+            std::vector<Statement> copies;
+        };
+        auto& statements = m_Function.statements;
+        const auto& blocks = m_Graph.Blocks();
+        // phis whose versions no statement reads, directly or through other
+        // phis, are left out; copy propagation can leave such phis behind,
+        // and their copies would read each other round the loops, which dead
+        // code elimination cannot see through
+        std::vector<bool> read(m_Function.variables.size(), false);
+        std::vector<uint32_t> worklist;
+        auto mark = [&](Operand operand) {
+            if (operand.type != OperandType::Variable || read[operand.id()]) return;
+            read[operand.id()] = true;
+            worklist.push_back(operand.id());
+        };
+        for (const auto& statement : statements)
+            for_each_use(statement, mark);
+        while (!worklist.empty())
+        {
+            const auto& site = m_Definitions[worklist.back()];
+            worklist.pop_back();
+            if (!site.phi) continue;
+            for (auto arg : m_Phis[site.block][site.index].args) mark(arg);
+        }
+        std::vector<Insertion> insertions;
+        std::vector<SplitEdge> splits;
+        std::vector<Statement> parallel, sequence;
+        auto scratch = Operand::Variable(static_cast<uint32_t>(m_Function.variables.size()));
+        StringId scratch_name = 0;
+        bool used_scratch = false;
+        for (uint32_t block = 0; block < blocks.size(); block++)
+        {
+            auto preds = m_Graph.Preds(block);
+            for (size_t edge = 0; edge < preds.size() && !m_Phis[block].empty(); edge++)
+            {
+                parallel.clear();
+                for (const auto& phi : m_Phis[block])
+                {
+                    if (!read[phi.dst.id()]) continue;
+                    auto copy = Statement::Assign(phi.dst, phi.args[edge]);
+                    if (!Same(copy.dst, copy.rhs)) parallel.push_back(copy);
+                }
+                if (parallel.empty()) continue;
+                sequence.clear();
+                if (Sequentialize(parallel, sequence, scratch))
+                {
+                    // named after a variable it saves, for listings
+                    auto save = std::find_if(sequence.begin(), sequence.end(), [scratch](const Statement& copy) { return Same(copy.dst, scratch); });
+                    scratch_name = m_Function.variables[save->rhs.id()].name;
+                    used_scratch = true;
+                }
+                const auto& pred = blocks[preds[edge]];
+                const auto* last = pred.end > pred.begin ? &statements[pred.end - 1] : nullptr;
+                auto place = [&](uint32_t position) {
+                    for (const auto& copy : sequence)
+                        insertions.push_back({ position, preds[edge], copy });
+                };
+                if (last != nullptr && last->type == StatementType::Condition)
+                {
+                    if (m_Graph.BlockOf(last->dst) == block)
+                    {
+                        auto label = Operand::Label(static_cast<uint32_t>(m_Function.label_positions.size()));
+                        m_Function.label_positions.push_back(NONE);
+                        splits.push_back({ pred.end - 1, label, sequence });
+                    }
+                    if (preds[edge] + 1 == block) place(pred.end);
+                }
+                else if (last != nullptr && last->type == StatementType::Goto) place(pred.end - 1);
+                else place(pred.end);
+            }
+        }
+        std::stable_sort(insertions.begin(), insertions.end(), [](const Insertion& a, const Insertion& b) {
+            return a.position != b.position ? a.position < b.position : a.block < b.block;
+        });
+
+        // rebuild the statements with the copies in place
+        std::vector<Operand> targets;
+        for (const auto& split : splits)
+        {
+            targets.push_back(statements[split.jump].dst);
+            statements[split.jump].dst = split.label;
+        }
+        auto size = static_cast<uint32_t>(statements.size());
+        std::vector<Statement> lowered;
+        lowered.reserve(size + insertions.size());
+        size_t next = 0;
+        for (uint32_t i = 0; i <= size; i++)
+        {
+            for (; next < insertions.size() && insertions[next].position == i; next++)
+                lowered.push_back(insertions[next].copy);
+            if (i == size) break;
+            const auto& statement = statements[i];
+            if (statement.type == StatementType::Label)
+                m_Function.label_positions[statement.dst.id()] = static_cast<uint32_t>(lowered.size());
+            lowered.push_back(statement);
+        }
+        if (!splits.empty())
+        {
+            // the split blocks go after the end of the function, which must
+            // not fall into them; falling off the end returns 0
+            if (lowered.empty() || (lowered.back().type != StatementType::Goto && lowered.back().type != StatementType::Return))
+                lowered.push_back(Statement::Return(Operand::Constant(0)));
+            for (size_t i = 0; i < splits.size(); i++)
+            {
+                m_Function.label_positions[splits[i].label.id()] = static_cast<uint32_t>(lowered.size());
+                lowered.push_back(Statement::Label(splits[i].label));
+                lowered.insert(lowered.end(), splits[i].copies.begin(), splits[i].copies.end());
+                lowered.push_back(Statement::Goto(targets[i]));
+            }
+        }
+        statements = std::move(lowered);
+        if (used_scratch) m_Function.variables.push_back({ scratch_name, 4 });
+        m_Phis.clear();
+        Coalesce();
+    }
+
+    void SSAForm::Coalesce()
+    {
+        // Two versions of a variable interfere if one is assigned while the
+        // other is live afterwards, unless the assignment copies the other:
+        // both then hold the same value. Versions that do not interfere can
+        // share one variable, so they are packed greedily, in order, into
+        // the first variable of their origin that none of their interfering
+        // versions went to, the origin itself first.
+        const auto count = static_cast<uint32_t>(m_Function.variables.size());
+        // the scratch is a variable of its own
+        auto origin = [this](uint32_t version) {
+            return version < m_Origins.size() ? m_Origins[version] : version;
+        };
+        ControlFlowGraph graph{ m_Function };
+        Liveness liveness{ graph };
+        auto& statements = m_Function.statements;
+        std::vector<std::vector<uint32_t>> interferes(count);
+        // the live versions of each origin during the backward walk of a
+        // block, and where each live version sits in its origin's list
+        std::vector<std::vector<uint32_t>> live(count);
+        std::vector<uint32_t> position(count, NONE);
+        // origins whose lists the block has touched, to clear after it
+        std::vector<uint32_t> touched;
+        auto enliven = [&](Operand operand) {
+            if (operand.type != OperandType::Variable || position[operand.id()] != NONE) return;
+            auto& versions = live[origin(operand.id())];
+            if (versions.empty()) touched.push_back(origin(operand.id()));
+            position[operand.id()] = static_cast<uint32_t>(versions.size());
+            versions.push_back(operand.id());
+        };
+        auto kill = [&](uint32_t version) {
+            if (position[version] == NONE) return;
+            auto& versions = live[origin(version)];
+            versions[position[version]] = versions.back();
+            position[versions.back()] = position[version];
+            versions.pop_back();
+            position[version] = NONE;
+        };
+        for (uint32_t block = 0; block < graph.Blocks().size(); block++)
+        {
+            liveness.ForEachLiveOut(block, enliven);
+            const auto& info = graph.Block(block);
+            for (auto i = info.end; i-- > info.begin;)
+            {
+                const auto& statement = statements[i];
+                if (AssignsVariable(statement))
+                {
+                    auto version = statement.dst.id();
+                    bool copy = statement.type == StatementType::Assign && statement.rhs.type == OperandType::Variable;
+                    for (auto other : live[origin(version)])
+                    {
+                        if (other == version || (copy && other == statement.rhs.id())) continue;
+                        interferes[version].push_back(other);
+                        interferes[other].push_back(version);
+                    }
+                    kill(version);
+                }
+                for_each_use(statement, enliven);
+            }
+            // the values live into the entry block are all there from the
+            // start, as if assigned together
+            if (block == 0)
+            {
+                for (auto variable : touched)
+                {
+                    const auto& versions = live[variable];
+                    for (auto version : versions)
+                    {
+                        for (auto other : versions)
+                        {
+                            if (other != version) interferes[version].push_back(other);
+                        }
+                    }
+                }
+            }
+            for (auto variable : touched)
+            {
+                for (auto version : live[variable]) position[version] = NONE;
+                live[variable].clear();
+            }
+            touched.clear();
+        }
+
+        // the variable each version goes to, and per origin the variables
+        // used so far; a variable is blocked for the version being placed
+        // once an interfering version went to it
+        std::vector<uint32_t> target(count, NONE), blocked(count, NONE);
+        std::vector<std::vector<uint32_t>> targets(count);
+        for (uint32_t version = 0; version < count; version++)
+        {
+            for (auto other : interferes[version])
+            {
+                if (target[other] != NONE) blocked[target[other]] = version;
+            }
+            auto& used = targets[origin(version)];
+            if (used.empty()) used.push_back(origin(version));
+            auto chosen = std::find_if(used.begin(), used.end(), [&](uint32_t variable) { return blocked[variable] != version; });
+            if (chosen == used.end())
+            {
+                used.push_back(version);
+                chosen = used.end() - 1;
+            }
+            target[version] = *chosen;
+        }
+
+        // rename, dropping the copies that now assign a variable to itself
+        auto rename = [&target](Operand& operand) {
+            if (operand.type == OperandType::Variable) operand = Operand::Variable(target[operand.id()]);
+        };
+        size_t kept = 0;
+        for (size_t i = 0; i < statements.size(); i++)
+        {
+            auto statement = statements[i];
+            for_each_use(statement, rename);
+            if (AssignsVariable(statement)) rename(statement.dst);
+            if (statement.type == StatementType::Assign && Same(statement.dst, statement.rhs)) continue;
+            if (statement.type == StatementType::Label)
+                m_Function.label_positions[statement.dst.id()] = static_cast<uint32_t>(kept);
+            statements[kept++] = statement;
+        }
+        statements.resize(kept);
+    }
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "cfg.hpp"
+#include "types.hpp"
+#include "utility/arena.hpp"
+#include "utility/interner.hpp"
+
+namespace TAC
+{
+    // Static single assignment form of the variables of a TAC function.
+    //
+    // Construction gives every assignment to a variable a new version of it,
+    // appended to the function's variables, and merges the versions reaching
+    // a block along different edges with a phi. Phis go on the iterated
+    // dominance frontiers of the assignments (Cytron et al.), and only where
+    // the variable is live on entry to the block, so that variables local to
+    // a block get none and a loop counter gets none at the loops around its
+    // own. A variable's own id stands for its value on entry to the
+    // function. Temps are not renamed.
+    //
+    // Lowering turns the phis whose versions are read into parallel copies
+    // on the incoming edges, splitting edges that leave a conditional jump.
+    // Passes over the SSA form are free to make versions of one variable
+    // overlap; copy propagation does, and a loop that swaps two variables
+    // then needs a scratch variable to order its copies. Afterwards the
+    // versions of a variable whose values are never needed at the same time
+    // are coalesced back into one variable, the original first, so only
+    // versions that overlap keep variables of their own and the copies
+    // between coalesced versions disappear.
+    class SSAForm
+    {
+    public:
+        static constexpr uint32_t NONE = ControlFlowGraph::NONE;
+
+        struct Phi
+        {
+            Operand dst;
+            // the version coming in from each predecessor of the block, in
+            // the order of its preds
+            std::vector<Operand> args;
+        };
+        // a statement of the function or, if phi is set, the index-th phi of
+        // block; the definition of entry versions has no block
+        struct Site
+        {
+            uint32_t block = NONE;
+            uint32_t index = 0;
+            bool phi = false;
+        };
+        explicit SSAForm(Function& function);
+
+        const ControlFlowGraph& Graph() const { return m_Graph; }
+        const std::vector<Phi>& Phis(uint32_t block) const { return m_Phis[block]; }
+        // the variable a version belongs to
+        uint32_t Origin(uint32_t version) const { return m_Origins[version]; }
+        const Site& Definition(uint32_t version) const { return m_Definitions[version]; }
+        ArenaArray<const Site> UsesOf(uint32_t version) const
+        {
+            return { m_Uses.data() + m_UseOffsets[version], m_UseOffsets[version + 1] - m_UseOffsets[version] };
+        }
+
+        void Print(std::ostream& out, const StringInterner& names) const;
+        // makes every version assigned from another one read that version
+        // instead; the copies are left for dead code elimination to remove.
+        // Returns the number of copies propagated.
+        size_t PropagateCopies();
+        // rewrites the function out of SSA form; the form is of no further
+        // use afterwards
+        void Lower();
+
+    private:
+        Function& m_Function;
+        ControlFlowGraph m_Graph;
+        // variables of the function before renaming
+        uint32_t m_VariableCount;
+        std::vector<std::vector<Phi>> m_Phis;
+        // per version, indexed like the function's variables
+        std::vector<uint32_t> m_Origins;
+        // how many versions a variable has for its entry version, the
+        // version's number among them for the others
+        std::vector<uint32_t> m_Numbers;
+        std::vector<Site> m_Definitions;
+        // uses of version v are m_Uses[m_UseOffsets[v], m_UseOffsets[v + 1])
+        std::vector<uint32_t> m_UseOffsets;
+        std::vector<Site> m_Uses;
+
+        void PlacePhis();
+        void Rename();
+        void RenameBlock(uint32_t block, std::vector<uint32_t>& current, std::vector<std::pair<uint32_t, uint32_t>>& trail);
+        uint32_t NewVersion(uint32_t variable, Site definition);
+        void LinkUses();
+        void Coalesce();
+    };
+};
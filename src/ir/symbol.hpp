@@ -1,33 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
-struct VarRange
-{
-    size_t start = 0, end = 0; 
-
-    VarRange()
-    {
-    }
-
-    VarRange(size_t start_and_end) : start(start_and_end), end(start_and_end)
-    {
-    }
-};
+#include "utility/interner.hpp"
 
 struct VarSymbol
 {
-    std::string var_name; 
+    StringId name = 0; 
     size_t byte_size = 1; 
-    bool is_temp = false; 
-    VarRange range; 
+    // index of the variable in its TAC function
+    uint32_t id = 0; 
 
     VarSymbol()
     {
     }
 
-    VarSymbol(const std::string& var_name, size_t byte_size) : var_name(var_name), byte_size(byte_size), range()
+    VarSymbol(StringId name, size_t byte_size) : name(name), byte_size(byte_size)
     {
     }
 
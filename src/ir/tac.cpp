@@ -4,117 +4,154 @@ void TACGenerator::GenerateStatements(AbstractSyntax::Ref root)
 {
     EvaluateSyntax(root); 
     if (m_Function != nullptr)
-        m_Functions.emplace_back(m_Function); 
+        m_Program.functions.emplace_back(std::move(m_Function)); 
 }
 
-void TACGenerator::LogStatements() const
+void TACGenerator::LogStatements(std::ostream& out) const
 {
     bool logLineNumber = true; 
     std::string prefix = "";
-    for (auto function : m_Functions)
+    for (const auto& function : m_Program.functions)
     {
         size_t counter = 0;
-        for (auto statement : function->statements)
+        auto format = [&](TAC::Operand operand) { return FormatOperand(*function, operand); }; 
+        for (const auto& statement : function->statements)
         {
             if (logLineNumber) prefix = std::to_string(counter) + ": ";
             counter++;
-            switch (statement->type())
-            {
-                case TAC::StatementType::Goto:
-                {
-                    auto _goto = TAC::Statement::RefCast<TAC::GotoStatement>(statement);
-                    std::cout << prefix << "goto " << _goto->label << "\n";
-                    break;
-                }
-                case TAC::StatementType::Condition:
-                {
-                    auto cond = TAC::Statement::RefCast<TAC::ConditionStatement>(statement); 
-                    std::cout << prefix << "if (" << cond->condition->to_string() << " != " << cond->value << ") goto " << cond->goto_label << "\n";
-                    break;
-                }
-                case TAC::StatementType::Assign:
-                {
-                    auto assign = TAC::Statement::RefCast<TAC::AssignStatement>(statement); 
-                    auto lhs = assign->lhs->var_name; 
-                    auto rhs = assign->rhs->to_string();
-                    std::cout << prefix << lhs << " = " << rhs << "\n"; 
-                    break;
-                }
-                case TAC::StatementType::Triple:
-                {
-                    auto triple = TAC::Statement::RefCast<TAC::TripleStatement>(statement);
-                    auto rhs = triple->rhs->to_string(); 
-                    auto dst = triple->dst;
-                    std::cout << prefix << dst->var_name << " = " << TAC::OP_CODE_SYMBOLS[triple->op] << rhs << "\n";
-                    break;
-                }
-                case TAC::StatementType::Quad:
-                {
-                    auto quad = TAC::Statement::RefCast<TAC::QuadStatement>(statement);
-                    auto lhs = quad->lhs->to_string();
-                    auto rhs = quad->rhs->to_string();
-                    std::cout << prefix << quad->dst->var_name << " = " << lhs 
-                        << " " << TAC::OP_CODE_SYMBOLS[quad->op] << " " << rhs << "\n"; 
-                    break;
-                }
-                case TAC::StatementType::Label:
-                {
-                    auto label = TAC::Statement::RefCast<TAC::LabelStatement>(statement);
-                    std::cout << prefix << label->name << ":\n";
-                    break;
-                }
-                case TAC::StatementType::Return:
-                {
-                    auto ret = TAC::Statement::RefCast<TAC::ReturnStatement>(statement);
-                    auto ret_val = ret->ret_val->to_string();
-                    std::cout << prefix << "RET " << ret_val << "\n"; 
-                    break;
-                }
-            }
+            out << prefix; 
+            TAC::print_statement(out, statement, format); 
         }
     }
 }    
 
-VarSymbol::Ref TACGenerator::CreateTempVar()
+std::string TACGenerator::FormatOperand(const TAC::Function& function, TAC::Operand operand) const
+{
+    switch (operand.type)
+    {
+        case TAC::OperandType::Constant:
+            return std::to_string(operand.value);
+        case TAC::OperandType::Variable:
+            return std::string(m_Names.Lookup(function.variables[operand.id()].name));
+        case TAC::OperandType::Temp:
+            return "t" + std::to_string(operand.id() + 1);
+        case TAC::OperandType::Label:
+            return TAC::label_name(operand.id());
+        case TAC::OperandType::None:
+            break;
+    }
+    return "";
+}
+
+TAC::Operand TACGenerator::CreateTempVar()
 {
     assert(m_Function);
-    auto name = "t" + std::to_string(++m_Function->temp_counter);
-    // find unsued name
-    while (m_VarContext.current_scope_has_var(name))
-        name = "t" + std::to_string(++m_Function->temp_counter); 
-    auto symbol = CreateRef<VarSymbol>(name, 4); 
-    symbol->is_temp = true;
-    symbol->range = VarRange(m_Function->statements.size());
-    m_VarContext.add_var(name, symbol);
-    return symbol;
+    // temps are only numbered, they never enter the scope
+    return TAC::Operand::Temp(m_Function->temp_count++);
+}
+
+TAC::Operand TACGenerator::CreateLabel()
+{
+    assert(m_Function);
+    // placed once its Label statement is added
+    auto id = static_cast<uint32_t>(m_Function->label_positions.size()); 
+    m_Function->label_positions.push_back(UINT32_MAX); 
+    return TAC::Operand::Label(id); 
 }
 
-std::string TACGenerator::CreateLabel()
+TAC::Operand TACGenerator::DeclareVar(StringId name)
 {
     assert(m_Function);
-    return "L" + std::to_string(++m_Function->label_counter); 
+    if (m_VarContext.current_scope_has_var(name))
+        throw std::runtime_error("error: Redeclaration of identifier '" + std::string(m_Names.Lookup(name)) + "'");
+    auto symbol = CreateRef<VarSymbol>(name, 4); 
+    symbol->id = static_cast<uint32_t>(m_Function->variables.size()); 
+    m_Function->variables.push_back({ name, 4 }); 
+    m_VarContext.add_var(name, symbol); 
+    return TAC::Operand::Variable(symbol->id); 
 }
 
-TAC::Operand::Ref TACGenerator::CreateOperand(AbstractSyntax::Ref syntax)
+void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref root)
 {
-    if (syntax->type() == SyntaxType::IntConstant)
-        return CreateRef<TAC::Operand>(AbstractSyntax::RefCast<IntConstant>(syntax));
-    else return EvaluateExpression(syntax);
+    // statements nested in other statements are evaluated off an explicit
+    // stack of tasks instead of recursing; whatever a statement emits after
+    // a nested one is queued behind it as an action
+    std::vector<SyntaxTask> tasks{ root }; 
+    while (!tasks.empty())
+    {
+        auto task = tasks.back(); 
+        tasks.pop_back(); 
+        RunTask(task, tasks); 
+    }
 }
 
-void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref syntax)
+void TACGenerator::RunTask(const SyntaxTask& task, std::vector<SyntaxTask>& tasks)
+{
+    switch (task.action)
+    {
+        case TaskAction::Visit:
+            VisitSyntax(task.syntax, tasks); 
+            break;
+        case TaskAction::Emit:
+            AddStatement(task.statement); 
+            break;
+        case TaskAction::PopScope:
+            m_VarContext.pop_scope(); 
+            break;
+        case TaskAction::EndDoWhile:
+        {
+            m_VarContext.pop_scope();
+            auto condition = CreateTempVar(); 
+            EvaluateExpression(AbstractSyntax::RefCast<DoWhileStatement>(task.syntax)->condition, condition); 
+            AddStatement(TAC::Statement::Condition(condition, task.start_label));
+            AddStatement(TAC::Statement::Label(task.end_label));
+            break;
+        }
+        case TaskAction::EndWhile:
+            m_VarContext.pop_scope();
+            AddStatement(TAC::Statement::Goto(task.start_label));
+            AddStatement(TAC::Statement::Label(task.end_label));
+            break;
+        case TaskAction::EndFor:
+        {
+            auto post_expression = task.syntax->type() == SyntaxType::For ? 
+                AbstractSyntax::RefCast<ForStatement>(task.syntax)->post_expression : 
+                AbstractSyntax::RefCast<ForDeclStatement>(task.syntax)->post_expression; 
+            AddStatement(TAC::Statement::Label(task.post_label));
+            if (post_expression != nullptr)
+                EvaluateExpression(post_expression);
+            AddStatement(TAC::Statement::Goto(task.start_label));
+            AddStatement(TAC::Statement::Label(task.end_label));
+            m_VarContext.pop_scope();
+            break;
+        }
+    }
+}
+
+void TACGenerator::Schedule(std::vector<SyntaxTask>& tasks, std::initializer_list<SyntaxTask> steps)
+{
+    // the stack runs last in, first out
+    tasks.insert(tasks.end(), std::rbegin(steps), std::rend(steps)); 
+}
+
+void TACGenerator::Schedule(std::vector<SyntaxTask>& tasks, const std::vector<SyntaxTask>& steps)
+{
+    tasks.insert(tasks.end(), steps.rbegin(), steps.rend()); 
+}
+
+void TACGenerator::VisitSyntax(AbstractSyntax::Ref syntax, std::vector<SyntaxTask>& tasks)
 {
     switch (syntax->type())
     {
         case SyntaxType::Program:
-            EvaluateSyntax(AbstractSyntax::RefCast<Program>(syntax)->function); 
+            tasks.emplace_back(AbstractSyntax::RefCast<Program>(syntax)->function); 
             break;
         case SyntaxType::Function:
         {
-            if (m_Function != nullptr) m_Functions.emplace_back(m_Function);
+            if (m_Function != nullptr) m_Program.functions.emplace_back(std::move(m_Function));
             auto astFunction = AbstractSyntax::RefCast<Function>(syntax);
-            m_Function = CreateRef<TAC::Function>(astFunction->name); 
-            EvaluateSyntax(astFunction->block); 
+            m_Function = std::make_unique<TAC::Function>(astFunction->name); 
+            tasks.emplace_back(astFunction->block); 
             break;
         }
         case SyntaxType::StatementExpression:
@@ -125,31 +162,26 @@ void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref syntax)
         }
         case SyntaxType::AssignmentOp:
         {
-            auto rhs = EvaluateExpression(AbstractSyntax::RefCast<AssignmentOp>(syntax)->rvalue); 
+            EvaluateExpression(AbstractSyntax::RefCast<AssignmentOp>(syntax)->rvalue); 
             break;
         }
         case SyntaxType::Declaration:
         {
             auto decl = AbstractSyntax::RefCast<Declaration>(syntax);
-            for (auto var : decl->variables)
+            for (const auto& var : decl->variables)
             {
-                if (m_VarContext.current_scope_has_var(var.name))
-                    throw std::runtime_error("error: Redeclaration of identifier '" + var.name + "'");
-                auto lhs = CreateRef<VarSymbol>(var.name, 4);   
-                m_VarContext.add_var(var.name, lhs); 
-                auto rhs = var.expression ? EvaluateExpression(var.expression, lhs) : 
-                    CreateRef<TAC::Operand>(CreateRef<IntConstant>(0)); 
-                lhs->range = VarRange(GetStatementsSize() - 1);
+                auto lhs = DeclareVar(var.name); 
+                if (var.expression) EvaluateExpression(var.expression, lhs); 
             }
             break;
         }
         case SyntaxType::CompoundBlock:    
         {
             auto block = AbstractSyntax::RefCast<CompoundBlock>(syntax); 
-            m_VarContext.push_scope(block->start_label, block->end_label);        
-            for (auto statement : block->statements)
-                EvaluateSyntax(statement);
-            m_VarContext.pop_scope(); 
+            m_VarContext.push_scope();        
+            std::vector<SyntaxTask> steps(block->statements.begin(), block->statements.end()); 
+            steps.emplace_back(TaskAction::PopScope); 
+            Schedule(tasks, steps); 
             break;
         }
         case SyntaxType::IfStatement:
@@ -158,30 +190,30 @@ void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref syntax)
             auto end_label = CreateLabel(); 
             auto if_label = CreateLabel(); 
             auto condition = EvaluateExpression(if_statement->if_conditional.condition);
-            UpdateRange(condition);
-            AddStatement(CreateRef<TAC::ConditionStatement>(condition, if_label));
+            AddStatement(TAC::Statement::Condition(condition, if_label));
             size_t len = if_statement->else_ifs.size(); 
-            std::vector<std::string> labels;
+            std::vector<TAC::Operand> labels;
             for (size_t i = 0; i < len; i++)
             {
                 labels.emplace_back(CreateLabel()); 
                 condition = EvaluateExpression(if_statement->else_ifs[i].condition);
-                UpdateRange(condition); 
-                AddStatement(CreateRef<TAC::ConditionStatement>(condition, labels[i]));
+                AddStatement(TAC::Statement::Condition(condition, labels[i]));
             }
+            std::vector<SyntaxTask> steps; 
             auto _else = if_statement->else_statement; 
             if (_else != nullptr) 
-                EvaluateSyntax(_else);
-            AddStatement(CreateRef<TAC::GotoStatement>(end_label));
+                steps.emplace_back(_else);
+            steps.emplace_back(TAC::Statement::Goto(end_label));
             for (size_t i = 0; i < len; i++)
             {
-                AddStatement(CreateRef<TAC::LabelStatement>(labels[i]));
-                EvaluateSyntax(if_statement->else_ifs[i].statement);
-                AddStatement(CreateRef<TAC::GotoStatement>(end_label));
+                steps.emplace_back(TAC::Statement::Label(labels[i]));
+                steps.emplace_back(if_statement->else_ifs[i].statement);
+                steps.emplace_back(TAC::Statement::Goto(end_label));
             }
-            AddStatement(CreateRef<TAC::LabelStatement>(if_label));
-            EvaluateSyntax(if_statement->if_conditional.statement);
-            AddStatement(CreateRef<TAC::LabelStatement>(end_label));
+            steps.emplace_back(TAC::Statement::Label(if_label));
+            steps.emplace_back(if_statement->if_conditional.statement);
+            steps.emplace_back(TAC::Statement::Label(end_label));
+            Schedule(tasks, steps); 
             break;
         }
         case SyntaxType::DoWhile:
@@ -189,14 +221,9 @@ void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref syntax)
             auto while_statement = AbstractSyntax::RefCast<DoWhileStatement>(syntax); 
             auto start_label = CreateLabel(); 
             auto end_label = CreateLabel();
-            AddStatement(CreateRef<TAC::LabelStatement>(start_label));
-            SetScopeLabels(while_statement->body, start_label, end_label);
-            EvaluateSyntax(while_statement->body);
-            auto condition = CreateTempVar(); 
-            auto operand = CreateRef<TAC::Operand>(condition);
-            EvaluateExpression(while_statement->condition, condition); 
-            AddStatement(CreateRef<TAC::ConditionStatement>(CreateRef<TAC::Operand>(condition), start_label));
-            AddStatement(CreateRef<TAC::LabelStatement>(end_label));
+            AddStatement(TAC::Statement::Label(start_label));
+            m_VarContext.push_scope(start_label.id(), end_label.id());
+            Schedule(tasks, { while_statement->body, SyntaxTask(TaskAction::EndDoWhile, syntax, start_label, {}, end_label) }); 
             break;
         }
         case SyntaxType::While:
@@ -205,241 +232,270 @@ void TACGenerator::EvaluateSyntax(AbstractSyntax::Ref syntax)
             auto start_label = CreateLabel(); 
             auto end_label = CreateLabel();
             auto condition = CreateTempVar(); 
-            auto operand = CreateRef<TAC::Operand>(condition); 
-            AddStatement(CreateRef<TAC::LabelStatement>(start_label));
+            AddStatement(TAC::Statement::Label(start_label));
             EvaluateExpression(while_statement->condition, condition); 
-            AddStatement(CreateRef<TAC::ConditionStatement>(operand, end_label, 1));
-            SetScopeLabels(while_statement->body, start_label, end_label);
-            EvaluateSyntax(while_statement->body);
-            AddStatement(CreateRef<TAC::GotoStatement>(start_label));
-            AddStatement(CreateRef<TAC::LabelStatement>(end_label));
+            AddStatement(TAC::Statement::Condition(condition, end_label, 1));
+            m_VarContext.push_scope(start_label.id(), end_label.id());
+            Schedule(tasks, { while_statement->body, SyntaxTask(TaskAction::EndWhile, syntax, start_label, {}, end_label) }); 
             break;
         }
         case SyntaxType::For:
-        {
-            auto for_statement = AbstractSyntax::RefCast<ForStatement>(syntax);
-            auto start_label = CreateLabel();
-            auto post_label = CreateLabel();  
-            auto end_label = CreateLabel(); 
-            // push loop header scope
-            m_VarContext.push_scope(post_label, end_label);
-            EvaluateExpression(AbstractSyntax::RefCast<Expression>(for_statement->expression));
-            AddStatement(CreateRef<TAC::LabelStatement>(start_label));
-            auto condition = CreateTempVar(); 
-            EvaluateExpression(for_statement->condition, condition); 
-            AddStatement(CreateRef<TAC::ConditionStatement>(CreateRef<TAC::Operand>(condition), end_label, 1));
-            EvaluateSyntax(for_statement->body);
-            AddStatement(CreateRef<TAC::LabelStatement>(post_label));
-            if (for_statement->post_expression != nullptr)
-                EvaluateExpression(AbstractSyntax::RefCast<Expression>(for_statement->post_expression));
-            AddStatement(CreateRef<TAC::GotoStatement>(start_label));
-            AddStatement(CreateRef<TAC::LabelStatement>(end_label));
-            m_VarContext.pop_scope();
-            break;
-        }
         case SyntaxType::ForDecl:
         {
-            auto for_statement = AbstractSyntax::RefCast<ForDeclStatement>(syntax);
-            auto start_label = CreateLabel(); 
+            // both loops share their layout, only the header differs
+            Statement::Ref body; 
+            auto start_label = CreateLabel();
             auto post_label = CreateLabel();  
             auto end_label = CreateLabel(); 
             // push loop header scope
-            m_VarContext.push_scope(post_label, end_label);
-            EvaluateSyntax(for_statement->declaration);
-            AddStatement(CreateRef<TAC::LabelStatement>(start_label));
+            m_VarContext.push_scope(post_label.id(), end_label.id());
+            Expression::Ref condition_expression; 
+            if (syntax->type() == SyntaxType::For)
+            {
+                auto for_statement = AbstractSyntax::RefCast<ForStatement>(syntax);
+                EvaluateExpression(for_statement->expression);
+                condition_expression = for_statement->condition; 
+                body = for_statement->body; 
+            } else {
+                auto for_statement = AbstractSyntax::RefCast<ForDeclStatement>(syntax);
+                VisitSyntax(for_statement->declaration, tasks);
+                condition_expression = for_statement->condition; 
+                body = for_statement->body; 
+            }
+            AddStatement(TAC::Statement::Label(start_label));
             auto condition = CreateTempVar(); 
-            EvaluateExpression(for_statement->condition, condition); 
-            AddStatement(CreateRef<TAC::ConditionStatement>(CreateRef<TAC::Operand>(condition), end_label, 1));
-            EvaluateSyntax(for_statement->body);
-            AddStatement(CreateRef<TAC::LabelStatement>(post_label));
-            if (for_statement->post_expression != nullptr)
-                EvaluateExpression(AbstractSyntax::RefCast<Expression>(for_statement->post_expression));
-            AddStatement(CreateRef<TAC::GotoStatement>(start_label));
-            AddStatement(CreateRef<TAC::LabelStatement>(end_label));
-            m_VarContext.pop_scope();
+            EvaluateExpression(condition_expression, condition); 
+            AddStatement(TAC::Statement::Condition(condition, end_label, 1));
+            Schedule(tasks, { body, SyntaxTask(TaskAction::EndFor, syntax, start_label, post_label, end_label) }); 
             break;
         }
         case SyntaxType::Break:
-            AddStatement(CreateRef<TAC::GotoStatement>(m_VarContext.get_end_label()));
+            AddStatement(TAC::Statement::Goto(TAC::Operand::Label(m_VarContext.get_end_label())));
             break;
         case SyntaxType::Continue:
-            AddStatement(CreateRef<TAC::GotoStatement>(m_VarContext.get_start_label()));
+            AddStatement(TAC::Statement::Goto(TAC::Operand::Label(m_VarContext.get_start_label())));
             break;
         case SyntaxType::Return:
         {
             auto ref = EvaluateExpression(AbstractSyntax::RefCast<ReturnStatement>(syntax)->expression); 
-            auto ret = CreateRef<TAC::ReturnStatement>(ref);
-            AddStatement(ret);  
+            AddStatement(TAC::Statement::Return(ref));  
             break;
         }
         case SyntaxType::Assignment:
         {
             auto assignment = AbstractSyntax::RefCast<Assignment>(syntax);
-            auto lhs = m_VarContext.get_var(assignment->lvalue);
+            auto lhs = TAC::Operand::Variable(m_VarContext.get_var(assignment->lvalue)->id);
             auto rhs = EvaluateExpression(assignment->rvalue);
-            auto assign = CreateRef<TAC::AssignStatement>(lhs, rhs); 
-            AddStatement(assign); 
+            AddStatement(TAC::Statement::Assign(lhs, rhs)); 
             break;
         }
     }
 }
 
-TAC::Operand::Ref TACGenerator::EvaluateExpression(AbstractSyntax::Ref syntax)
+TAC::Operand TACGenerator::EvaluateExpression(AbstractSyntax::Ref syntax)
 {
-    return EvaluateExpression(syntax, nullptr);
+    return EvaluateExpression(syntax, TAC::Operand());
 }
 
-TAC::Operand::Ref TACGenerator::EvaluateExpression(AbstractSyntax::Ref syntax, VarSymbol::Ref dst)
+TAC::Operand TACGenerator::EvaluateExpression(AbstractSyntax::Ref syntax, TAC::Operand dst)
 {
-    switch (syntax->type())
+    // Operands are evaluated off an explicit stack of frames instead of
+    // recursing. A frame pushes the operand it needs next and advances its
+    // state; once the operand is done the frame is back on top and finds
+    // the operand's value in result. 
+    std::vector<ExpressionFrame> frames{ ExpressionFrame(syntax, dst) }; 
+    TAC::Operand result; 
+    while (!frames.empty())
     {
-        case SyntaxType::UnaryOp:
+        auto& frame = frames.back(); 
+        auto state = frame.state++; 
+        // push_back may move the frames, so it has to come last
+        auto evaluate = [&frames](AbstractSyntax::Ref operand) { frames.emplace_back(operand, TAC::Operand()); }; 
+        switch (frame.syntax->type())
         {
-            auto op = AbstractSyntax::RefCast<UnaryOp>(syntax);
-            if (dst == nullptr) dst = CreateTempVar(); 
-            switch (op->OpType())
+            case SyntaxType::UnaryOp:
             {
-                case UnaryOpType::PostfixDecrement:
-                case UnaryOpType::PostfixIncrement:
+                auto op = AbstractSyntax::RefCast<UnaryOp>(frame.syntax);
+                if (state == 0)
                 {
-                    auto rhs = CreateOperand(op->expr); 
-                    auto op_code = op->OpType() == UnaryOpType::PostfixDecrement ? TAC::OpCode::SUB :
-                        TAC::OpCode::ADD;
-                    UpdateRange(rhs);
-                    AddStatement(CreateRef<TAC::AssignStatement>(dst, rhs)); 
-                    AddStatement(CreateRef<TAC::QuadStatement>(op_code, 
-                        rhs, CreateRef<TAC::Operand>(CreateRef<IntConstant>(1)), rhs->get_symbol()));
-                    return CreateRef<TAC::Operand>(dst);
+                    if (frame.dst.empty()) frame.dst = CreateTempVar(); 
+                    evaluate(op->expr); 
+                    break; 
                 }
-                case UnaryOpType::PrefixDecrement:
-                case UnaryOpType::PrefixIncrement:
+                auto dst = frame.dst; 
+                auto rhs = result; 
+                switch (op->OpType())
                 {
-                    auto rhs = CreateOperand(op->expr); 
-                    auto op_code = op->OpType() == UnaryOpType::PrefixDecrement ? TAC::OpCode::SUB :
-                        TAC::OpCode::ADD;
-                    UpdateRange(rhs);
-                    AddStatement(CreateRef<TAC::QuadStatement>(op_code, 
-                        rhs, CreateRef<TAC::Operand>(CreateRef<IntConstant>(1)), rhs->get_symbol()));
-                    AddStatement(CreateRef<TAC::AssignStatement>(dst, rhs)); 
-                    return CreateRef<TAC::Operand>(dst);
+                    case UnaryOpType::PostfixDecrement:
+                    case UnaryOpType::PostfixIncrement:
+                    {
+                        auto op_code = op->OpType() == UnaryOpType::PostfixDecrement ? TAC::OpCode::SUB :
+                            TAC::OpCode::ADD;
+                        AddStatement(TAC::Statement::Assign(dst, rhs)); 
+                        AddStatement(TAC::Statement::Quad(op_code, rhs, TAC::Operand::Constant(1), rhs));
+                        break;
+                    }
+                    case UnaryOpType::PrefixDecrement:
+                    case UnaryOpType::PrefixIncrement:
+                    {
+                        auto op_code = op->OpType() == UnaryOpType::PrefixDecrement ? TAC::OpCode::SUB :
+                            TAC::OpCode::ADD;
+                        AddStatement(TAC::Statement::Quad(op_code, rhs, TAC::Operand::Constant(1), rhs));
+                        AddStatement(TAC::Statement::Assign(dst, rhs)); 
+                        break;
+                    }
+                    default:
+                        AddStatement(TAC::Statement::Triple(TAC::convert_unary_op(op->OpType()), rhs, dst));
+                        break;
                 }
+                result = dst;
+                frames.pop_back(); 
+                break;
             }
-            auto rhs = CreateOperand(op->expr); 
-            UpdateRange(rhs);
-            auto triple = CreateRef<TAC::TripleStatement>(TAC::convert_unary_op(op->OpType()), rhs, dst); 
-            AddStatement(triple);
-            return CreateRef<TAC::Operand>(dst);
-        }
-        case SyntaxType::BinaryOp:
-        {
-            auto op = AbstractSyntax::RefCast<BinaryOp>(syntax);
-            auto lhs = CreateOperand(op->lvalue);
-            UpdateRange(lhs); 
-            switch (op->OpType())
+            case SyntaxType::BinaryOp:
             {
-                case BinaryOpType::LogicalAnd:
-                case BinaryOpType::LogicalOr:
+                auto op = AbstractSyntax::RefCast<BinaryOp>(frame.syntax);
+                bool logical = op->OpType() == BinaryOpType::LogicalAnd || op->OpType() == BinaryOpType::LogicalOr; 
+                if (state == 0)
+                {
+                    evaluate(op->lvalue); 
+                    break; 
+                }
+                if (state == 1)
                 {
-                    auto set_label = CreateLabel(); 
-                    auto end_label = CreateLabel(); 
-                    auto condition = CreateTempVar(); 
-                    auto quad = CreateRef<TAC::QuadStatement>(TAC::OpCode::NEQL, 
-                        CreateRef<TAC::Operand>(CreateRef<IntConstant>(0)), lhs, condition); 
-                    AddStatement(quad);
-                    AddStatement(CreateRef<TAC::ConditionStatement>(CreateRef<TAC::Operand>(condition), set_label,
-                        op->OpType() == BinaryOpType::LogicalAnd ? 1 : 0));
-                    auto rhs = CreateOperand(op->rvalue);
-                    UpdateRange(rhs);
-                    if (dst == nullptr) dst = CreateTempVar();
-                    quad = CreateRef<TAC::QuadStatement>(TAC::OpCode::NEQL, 
-                        CreateRef<TAC::Operand>(CreateRef<IntConstant>(0)), rhs, dst); 
-                    AddStatement(quad);
-                    AddStatement(CreateRef<TAC::GotoStatement>(end_label));
-                    AddStatement(CreateRef<TAC::LabelStatement>(set_label));
-                    AddStatement(CreateRef<TAC::AssignStatement>(dst, 
-                        CreateRef<TAC::Operand>(CreateRef<IntConstant>(op->OpType() == BinaryOpType::LogicalAnd ? 0 : 1))));
-                    AddStatement(CreateRef<TAC::LabelStatement>(end_label));
-                    return CreateRef<TAC::Operand>(dst); 
+                    auto lhs = result; 
+                    frame.operand = lhs; 
+                    if (logical)
+                    {
+                        // short-circuit: skip the right hand side once the left one decides
+                        frame.labels[0] = CreateLabel(); 
+                        frame.labels[1] = CreateLabel(); 
+                        auto condition = CreateTempVar(); 
+                        AddStatement(TAC::Statement::Quad(TAC::OpCode::NEQL, 
+                            TAC::Operand::Constant(0), lhs, condition));
+                        AddStatement(TAC::Statement::Condition(condition, frame.labels[0],
+                            op->OpType() == BinaryOpType::LogicalAnd ? 1 : 0));
+                    }
+                    evaluate(op->rvalue); 
+                    break; 
                 }
-            }                
-            auto rhs = CreateOperand(op->rvalue);
-            UpdateRange(rhs);
-            if (op->OpType() == BinaryOpType::Comma)
+                auto rhs = result; 
+                if (logical)
+                {
+                    if (frame.dst.empty()) frame.dst = CreateTempVar();
+                    auto dst = frame.dst; 
+                    AddStatement(TAC::Statement::Quad(TAC::OpCode::NEQL, 
+                        TAC::Operand::Constant(0), rhs, dst));
+                    AddStatement(TAC::Statement::Goto(frame.labels[1]));
+                    AddStatement(TAC::Statement::Label(frame.labels[0]));
+                    AddStatement(TAC::Statement::Assign(dst, 
+                        TAC::Operand::Constant(op->OpType() == BinaryOpType::LogicalAnd ? 0 : 1)));
+                    AddStatement(TAC::Statement::Label(frame.labels[1]));
+                    result = dst; 
+                } else if (op->OpType() == BinaryOpType::Comma) {
+                    if (!frame.dst.empty())
+                        AddStatement(TAC::Statement::Assign(frame.dst, rhs));
+                    result = rhs; 
+                } else {
+                    if (frame.dst.empty()) frame.dst = CreateTempVar(); 
+                    AddStatement(TAC::Statement::Quad(TAC::convert_binary_op(op->OpType()), 
+                        frame.operand, rhs, frame.dst));
+                    result = frame.dst; 
+                }
+                frames.pop_back(); 
+                break;
+            }
+            case SyntaxType::TernaryOp:
             {
-                AddStatement(CreateRef<TAC::AssignStatement>(dst, rhs));
-                return rhs; 
+                auto op = AbstractSyntax::RefCast<TernaryOp>(frame.syntax);
+                // labels[0] jumps to the true branch, labels[1] past both
+                switch (state)
+                {
+                    case 0:
+                        frame.labels[1] = CreateLabel(); 
+                        frame.labels[0] = CreateLabel();
+                        if (frame.dst.empty()) frame.dst = CreateTempVar();
+                        evaluate(op->condition); 
+                        break; 
+                    case 1:
+                        AddStatement(TAC::Statement::Condition(result, frame.labels[0]));
+                        evaluate(op->rvalue); 
+                        break; 
+                    case 2:
+                        AddStatement(TAC::Statement::Assign(frame.dst, result));
+                        AddStatement(TAC::Statement::Goto(frame.labels[1])); 
+                        AddStatement(TAC::Statement::Label(frame.labels[0]));
+                        evaluate(op->lvalue); 
+                        break; 
+                    default:
+                        AddStatement(TAC::Statement::Assign(frame.dst, result));
+                        AddStatement(TAC::Statement::Label(frame.labels[1])); 
+                        result = frame.dst;
+                        frames.pop_back(); 
+                        break; 
+                }
+                break;
             }
-            if (dst == nullptr) dst = CreateTempVar(); 
-            auto quad = CreateRef<TAC::QuadStatement>(TAC::convert_binary_op(op->OpType()), 
-                lhs, rhs, dst); 
-            AddStatement(quad);
-            return CreateRef<TAC::Operand>(dst); 
-        }
-        case SyntaxType::TernaryOp:
-        {
-            auto op = AbstractSyntax::RefCast<TernaryOp>(syntax);
-            auto end = CreateLabel(); 
-            auto set = CreateLabel();
-            if (dst == nullptr) dst = CreateTempVar();
-            auto condition = EvaluateExpression(op->condition);
-            AddStatement(CreateRef<TAC::ConditionStatement>(condition, set));
-            auto rvalue = EvaluateExpression(op->rvalue); 
-            AddStatement(CreateRef<TAC::AssignStatement>(dst, rvalue));
-            AddStatement(CreateRef<TAC::GotoStatement>(end)); 
-            AddStatement(CreateRef<TAC::LabelStatement>(set));
-            auto lvalue = EvaluateExpression(op->lvalue); 
-            AddStatement(CreateRef<TAC::AssignStatement>(dst, lvalue));
-            AddStatement(CreateRef<TAC::LabelStatement>(end)); 
-            return CreateRef<TAC::Operand>(dst);
-        }
-        case SyntaxType::AssignmentOp:
-        {
-            auto op = AbstractSyntax::RefCast<AssignmentOp>(syntax); 
-            auto lhs = m_VarContext.get_var(op->lvalue);
-            auto lhsOperand = CreateRef<TAC::Operand>(lhs);
-            auto rhs = CreateOperand(op->rvalue);
-            UpdateRange(lhs); 
-            UpdateRange(rhs); 
-            auto quad = CreateRef<TAC::QuadStatement>(TAC::convert_assignment_op(op->OpType()), 
-                lhsOperand, rhs, lhs); 
-            AddStatement(quad); 
-            return lhsOperand; 
-        }
-        case SyntaxType::IntConstant:
-        {
-            auto constant = AbstractSyntax::RefCast<IntConstant>(syntax);
-            if (dst != nullptr)
-                AddStatement(CreateRef<TAC::AssignStatement>(dst, CreateRef<TAC::Operand>(constant)));
-            return CreateRef<TAC::Operand>(constant); 
-        }
-        case SyntaxType::VariableRef:
-        {
-            auto ref = AbstractSyntax::RefCast<VariableRef>(syntax);
-            auto symbol = m_VarContext.get_var(ref->name);
-            UpdateRange(symbol);
-            if (dst != nullptr)
-                AddStatement(CreateRef<TAC::AssignStatement>(dst, CreateRef<TAC::Operand>(symbol)));
-            return CreateRef<TAC::Operand>(symbol);
-        }
-        case SyntaxType::Null:
-            return nullptr; 
-        case SyntaxType::Assignment:
-        {
-            auto assignment = AbstractSyntax::RefCast<Assignment>(syntax);
-            auto lhs = m_VarContext.get_var(assignment->lvalue);
-            auto rhs = CreateOperand(assignment->rvalue);
-            UpdateRange(lhs);
-            UpdateRange(rhs);
-            auto assign = CreateRef<TAC::AssignStatement>(lhs, rhs); 
-            AddStatement(assign); 
-            if (dst != nullptr)
+            case SyntaxType::AssignmentOp:
             {
-                UpdateRange(lhs);
-                AddStatement(CreateRef<TAC::AssignStatement>(dst, CreateRef<TAC::Operand>(lhs)));
+                auto op = AbstractSyntax::RefCast<AssignmentOp>(frame.syntax); 
+                if (state == 0)
+                {
+                    frame.symbol = TAC::Operand::Variable(m_VarContext.get_var(op->lvalue)->id);
+                    evaluate(op->rvalue); 
+                    break; 
+                }
+                auto lhs = frame.symbol; 
+                auto rhs = result;
+                AddStatement(TAC::Statement::Quad(TAC::convert_assignment_op(op->OpType()), lhs, rhs, lhs)); 
+                result = lhs; 
+                frames.pop_back(); 
+                break;
             }
-            return rhs;
+            case SyntaxType::Assignment:
+            {
+                auto assignment = AbstractSyntax::RefCast<Assignment>(frame.syntax);
+                if (state == 0)
+                {
+                    frame.symbol = TAC::Operand::Variable(m_VarContext.get_var(assignment->lvalue)->id);
+                    evaluate(assignment->rvalue); 
+                    break; 
+                }
+                auto lhs = frame.symbol; 
+                auto rhs = result;
+                AddStatement(TAC::Statement::Assign(lhs, rhs)); 
+                if (!frame.dst.empty())
+                    AddStatement(TAC::Statement::Assign(frame.dst, lhs));
+                frames.pop_back(); 
+                break;
+            }
+            case SyntaxType::IntConstant:
+            {
+                auto constant = AbstractSyntax::RefCast<IntConstant>(frame.syntax);
+                if (!frame.dst.empty())
+                    AddStatement(TAC::Statement::Assign(frame.dst, TAC::Operand::Constant(constant->value)));
+                result = TAC::Operand::Constant(constant->value); 
+                frames.pop_back(); 
+                break;
+            }
+            case SyntaxType::VariableRef:
+            {
+                auto ref = AbstractSyntax::RefCast<VariableRef>(frame.syntax);
+                auto symbol = TAC::Operand::Variable(m_VarContext.get_var(ref->name)->id);
+                if (!frame.dst.empty())
+                    AddStatement(TAC::Statement::Assign(frame.dst, symbol));
+                result = symbol;
+                frames.pop_back(); 
+                break;
+            }
+            case SyntaxType::Null:
+                result = TAC::Operand(); 
+                frames.pop_back(); 
+                break;
+            default:
+                assert(false);
+                return TAC::Operand(); 
         }
     }
-    assert(false);
-    return nullptr; 
-}
\ No newline at end of file
+    return result; 
+}
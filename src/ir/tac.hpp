@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -16,56 +18,100 @@
 class TACGenerator
 {
 public:
+    TACGenerator(StringInterner& names) : m_Names(names), m_VarContext(names)
+    {
+    }
+
     void GenerateStatements(AbstractSyntax::Ref root);
-    void LogStatements() const; 
+    void LogStatements(std::ostream& out) const; 
 
-    const std::vector<TAC::Function::Ref>& GetFunctions() const { return m_Functions; }
-    VarContext& GetVarContext() { return m_VarContext; }
+    // hands the generated functions over, leaving the generator empty
+    TAC::Program TakeProgram() { return std::move(m_Program); }
+    const StringInterner& GetInterner() const { return m_Names; }
 protected:
+    // identifiers of the tree, temporaries are interned next to them
+    StringInterner& m_Names; 
     TAC::Function::Ref m_Function;
-    std::vector<TAC::Function::Ref> m_Functions; 
+    TAC::Program m_Program; 
     VarContext m_VarContext;
 
-    inline VarSymbol::Ref CreateTempVar();
-    inline std::string CreateLabel();
-    inline TAC::Operand::Ref CreateOperand(AbstractSyntax::Ref syntax);
-
-    void EvaluateSyntax(AbstractSyntax::Ref syntax);
-    TAC::Operand::Ref EvaluateExpression(AbstractSyntax::Ref syntax);
-    TAC::Operand::Ref EvaluateExpression(AbstractSyntax::Ref syntax, VarSymbol::Ref dst);
+    inline TAC::Operand CreateTempVar();
+    inline TAC::Operand CreateLabel();
 
-    inline size_t GetStatementsSize()
+    // what a pending task of the statement walk does when it is popped
+    enum class TaskAction : uint8_t
     {
-        assert(m_Function); 
-        return m_Function->statements.size(); 
-    }
+        Visit,
+        Emit,
+        PopScope,
+        // the code that follows the body of a loop
+        EndDoWhile,
+        EndWhile,
+        EndFor
+    };
 
-    inline void SetScopeLabels(AbstractSyntax::Ref syntax, const std::string& start_label, const std::string& end_label)
+    // a pending unit of work of the statement walk: either a statement to
+    // visit or code to emit once the statements queued before it are done
+    struct SyntaxTask
     {
-        if (syntax->type() == SyntaxType::CompoundBlock)
+        TaskAction action; 
+        // the statement to visit, or the loop a loop end belongs to
+        AbstractSyntax::Ref syntax = nullptr; 
+        // the statement to emit
+        TAC::Statement statement{}; 
+        TAC::Operand start_label, post_label, end_label; 
+
+        SyntaxTask(AbstractSyntax::Ref syntax) : action(TaskAction::Visit), syntax(syntax)
         {
-            auto block = AbstractSyntax::RefCast<CompoundBlock>(syntax);
-            block->start_label = start_label;
-            block->end_label = end_label;
         }
-    }
 
-    inline void AddStatement(TAC::Statement::Ref statement)
+        SyntaxTask(const TAC::Statement& statement) : action(TaskAction::Emit), statement(statement)
+        {
+        }
+
+        SyntaxTask(TaskAction action, AbstractSyntax::Ref syntax = nullptr, 
+            TAC::Operand start_label = {}, TAC::Operand post_label = {}, TAC::Operand end_label = {}) : 
+            action(action), syntax(syntax), start_label(start_label), post_label(post_label), end_label(end_label)
+        {
+        }
+    };
+
+    // an expression whose operands are still being evaluated
+    struct ExpressionFrame
     {
-        assert(m_Function);
-        m_Function->statements.emplace_back(statement); 
-    }
+        AbstractSyntax::Ref syntax; 
+        TAC::Operand dst; 
+        uint8_t state = 0; 
+        TAC::Operand operand; 
+        TAC::Operand symbol; 
+        TAC::Operand labels[2]; 
+
+        ExpressionFrame(AbstractSyntax::Ref syntax, TAC::Operand dst) : syntax(syntax), dst(dst)
+        {
+        }
+    };
 
-    inline void UpdateRange(VarSymbol::Ref var_symbol)
+    void EvaluateSyntax(AbstractSyntax::Ref root);
+    void VisitSyntax(AbstractSyntax::Ref syntax, std::vector<SyntaxTask>& tasks);
+    void RunTask(const SyntaxTask& task, std::vector<SyntaxTask>& tasks);
+    static void Schedule(std::vector<SyntaxTask>& tasks, std::initializer_list<SyntaxTask> steps);
+    static void Schedule(std::vector<SyntaxTask>& tasks, const std::vector<SyntaxTask>& steps);
+    TAC::Operand EvaluateExpression(AbstractSyntax::Ref syntax);
+    TAC::Operand EvaluateExpression(AbstractSyntax::Ref syntax, TAC::Operand dst);
+    TAC::Operand DeclareVar(StringId name);
+    std::string FormatOperand(const TAC::Function& function, TAC::Operand operand) const;
+
+    inline size_t GetStatementsSize()
     {
-        assert(m_Function);
-        var_symbol->range.end = GetStatementsSize();
+        assert(m_Function); 
+        return m_Function->statements.size(); 
     }
-    
-    inline void UpdateRange(TAC::Operand::Ref operand)
+
+    inline void AddStatement(const TAC::Statement& statement)
     {
         assert(m_Function);
-        if (operand->type() == TAC::OperandType::Symbol)
-            operand->get_symbol()->range.end = GetStatementsSize();
+        if (statement.type == TAC::StatementType::Label)
+            m_Function->label_positions[statement.dst.id()] = static_cast<uint32_t>(GetStatementsSize()); 
+        m_Function->statements.push_back(statement); 
     }
 };
\ No newline at end of file
@@ -1,14 +1,20 @@
 #pragma once
 
-#include <unordered_map>
-#include <variant>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "parser/syntax/includes.hpp"
 #include "symbol.hpp"
+#include "utility/enum_table.hpp"
 
 namespace TAC
 {
-    enum class OpCode : int
+    enum class OpCode : uint8_t
     {
         NEG,
         NOT,
@@ -33,7 +39,13 @@ namespace TAC
         BOOL_OR,
         ERR
     };
-    static std::unordered_map<OpCode, std::string> OP_CODE_SYMBOLS 
+    struct OpCodeSymbol
+    {
+        OpCode key; 
+        std::string_view symbol; 
+    };
+    // infix spelling of each opcode in TAC listings, in enum order
+    static constexpr OpCodeSymbol OP_CODE_SYMBOLS[] =
     {
         { OpCode::NEG,      "-"   },
         { OpCode::NOT,      "~"   },
@@ -58,52 +70,37 @@ namespace TAC
         { OpCode::BOOL_OR,  "||"  },
         { OpCode::ERR,      "ERR" }
     };
-    enum class OperandType : int
+    static_assert(is_enum_indexed(OP_CODE_SYMBOLS, static_cast<size_t>(OpCode::ERR) + 1), "OP_CODE_SYMBOLS is out of step with OpCode"); 
+
+    static constexpr std::string_view op_code_symbol(OpCode op)
     {
+        return OP_CODE_SYMBOLS[static_cast<size_t>(op)].symbol; 
+    }
+    enum class OperandType : uint8_t
+    {
+        None,
         Constant,
-        Symbol,
+        Variable,
+        Temp,
         Label
     };
-    class Operand
+    // An immediate, or the index of a variable, temp or label of the
+    // function the operand appears in. Temps are virtual registers:
+    // they have no name or scope, only a number.
+    struct Operand
     {
-    public:
-        std::variant<IntConstant::Ref, VarSymbol::Ref, std::string> member; 
-        
-        Operand(IntConstant::Ref constant) : m_Type(OperandType::Constant), member(constant)
-        {
-        }
+        OperandType type = OperandType::None; 
+        int32_t value = 0; 
 
-        Operand(VarSymbol::Ref var_symbol) : m_Type(OperandType::Symbol), member(var_symbol)
-        {
-        }
-
-        Operand(const std::string& label) : m_Type(OperandType::Label), member(label)
-        {
-        }
+        static constexpr Operand Constant(int value) { return { OperandType::Constant, value }; }
+        static constexpr Operand Variable(uint32_t id) { return { OperandType::Variable, static_cast<int32_t>(id) }; }
+        static constexpr Operand Temp(uint32_t id) { return { OperandType::Temp, static_cast<int32_t>(id) }; }
+        static constexpr Operand Label(uint32_t id) { return { OperandType::Label, static_cast<int32_t>(id) }; }
 
-        std::string to_string()
-        {
-            switch (m_Type)
-            {
-                case OperandType::Constant:
-                    return std::to_string(std::get<IntConstant::Ref>(member)->value);
-                case OperandType::Symbol:
-                    return std::get<VarSymbol::Ref>(member)->var_name;
-                case OperandType::Label:
-                    return std::get<std::string>(member);
-            }
-        }
-
-        int get_value() { return std::get<IntConstant::Ref>(member)->value; }
-        VarSymbol::Ref get_symbol() { return std::get<VarSymbol::Ref>(member); }
-        const std::string& get_label() { return std::get<std::string>(member); }
-        OperandType type() { return m_Type; }
-
-        typedef std::shared_ptr<Operand> Ref; 
-    private:
-        OperandType m_Type; 
+        bool empty() const { return type == OperandType::None; }
+        uint32_t id() const { return static_cast<uint32_t>(value); }
     };
-    enum class StatementType : int
+    enum class StatementType : uint8_t
     {
         Goto,
         Condition,
@@ -113,115 +110,153 @@ namespace TAC
         Label,
         Return
     };
-    class Statement 
+    // A TAC statement is a fixed-size value; the operands it uses depend on
+    // its type:
+    //   Goto        goto dst
+    //   Condition   if (lhs != rhs) goto dst
+    //   Assign      dst = rhs
+    //   Triple      dst = op rhs
+    //   Quad        dst = lhs op rhs
+    //   Label       dst:
+    //   Return      RET rhs
+    struct Statement
     {
-    public:
-        virtual ~Statement() = default;
-        StatementType type() { return m_Type; }
-        typedef std::shared_ptr<Statement> Ref; 
-        template<typename T>
-        static std::shared_ptr<T> RefCast(Ref ref)
-        {
-            return std::dynamic_pointer_cast<T>(ref); 
-        }
-    protected:
-        StatementType m_Type;
-        Statement(StatementType type) : m_Type(type)
+        StatementType type; 
+        OpCode op = OpCode::ERR; 
+        Operand dst, lhs, rhs; 
+
+        static constexpr Statement Goto(Operand label)
         {
+            return { StatementType::Goto, OpCode::ERR, label, {}, {} }; 
         }
-    };
-    struct GotoStatement : public Statement
-    {
-        std::string label;
 
-        GotoStatement(const std::string& label) : Statement(StatementType::Goto), label(label)
+        static constexpr Statement Condition(Operand condition, Operand label, int value = 0)
         {
+            return { StatementType::Condition, OpCode::ERR, label, condition, Operand::Constant(value) }; 
         }
 
-        typedef std::shared_ptr<GotoStatement> Ref; 
-    };
-    struct ConditionStatement : public Statement
-    {
-        Operand::Ref condition; 
-        std::string goto_label; 
-        int value = 0;
-
-        ConditionStatement(Operand::Ref condition, const std::string& goto_label) : Statement(StatementType::Condition), condition(condition), goto_label(goto_label)
+        static constexpr Statement Assign(Operand dst, Operand rhs)
         {
+            return { StatementType::Assign, OpCode::ERR, dst, {}, rhs }; 
         }
 
-        ConditionStatement(Operand::Ref condition, const std::string& goto_label, int value) : 
-            Statement(StatementType::Condition), condition(condition), goto_label(goto_label), value(value)
+        static constexpr Statement Triple(OpCode op, Operand rhs, Operand dst)
         {
+            return { StatementType::Triple, op, dst, {}, rhs }; 
         }
 
-        typedef std::shared_ptr<ConditionStatement> Ref; 
-    };
-    struct AssignStatement : public Statement
-    {
-        VarSymbol::Ref lhs; 
-        Operand::Ref rhs;
-
-        AssignStatement(VarSymbol::Ref lhs, Operand::Ref rhs) : Statement(StatementType::Assign), lhs(lhs), rhs(rhs)
+        static constexpr Statement Quad(OpCode op, Operand lhs, Operand rhs, Operand dst)
         {
-        } 
-
-        typedef std::shared_ptr<AssignStatement> Ref; 
-    };
-    struct TripleStatement : public Statement
-    {
-        OpCode op; 
-        Operand::Ref rhs; 
-        VarSymbol::Ref dst; 
+            return { StatementType::Quad, op, dst, lhs, rhs }; 
+        }
 
-        TripleStatement(OpCode op, Operand::Ref rhs, VarSymbol::Ref dst) : Statement(StatementType::Triple), op(op), rhs(rhs), dst(dst)
+        static constexpr Statement Label(Operand label)
         {
+            return { StatementType::Label, OpCode::ERR, label, {}, {} }; 
         }
 
-        typedef std::shared_ptr<TripleStatement> Ref; 
-    };
-    struct QuadStatement : public Statement
-    {
-        OpCode op;
-        Operand::Ref lhs, rhs; 
-        VarSymbol::Ref dst; 
-
-        QuadStatement(OpCode op, Operand::Ref lhs, Operand::Ref rhs, VarSymbol::Ref dst) : Statement(StatementType::Quad), op(op), lhs(lhs), rhs(rhs), dst(dst) 
+        static constexpr Statement Return(Operand ret_val)
         {
+            return { StatementType::Return, OpCode::ERR, {}, {}, ret_val }; 
         }
-
-        typedef std::shared_ptr<QuadStatement> Ref;         
     };
-    struct LabelStatement : public Statement
+    static_assert(std::is_trivially_copyable_v<Statement> && sizeof(Statement) <= 32, "TAC statements are meant to be small values"); 
+    // whether the statement stores a value into its dst operand
+    static constexpr bool assigns_value(const Statement& statement)
     {
-        std::string name; 
-
-        LabelStatement(const std::string& name) : Statement(StatementType::Label), name(name)
+        return statement.type == StatementType::Assign || statement.type == StatementType::Triple ||
+            statement.type == StatementType::Quad;
+    }
+    // calls use on every operand the statement reads, constants included;
+    // works on const and mutable statements alike
+    template <typename S, typename Use>
+    void for_each_use(S& statement, Use use)
+    {
+        switch (statement.type)
         {
+            case StatementType::Condition:
+                use(statement.lhs);
+                break;
+            case StatementType::Quad:
+                use(statement.lhs);
+                use(statement.rhs);
+                break;
+            case StatementType::Assign:
+            case StatementType::Triple:
+            case StatementType::Return:
+                use(statement.rhs);
+                break;
+            case StatementType::Goto:
+            case StatementType::Label:
+                break;
         }
-
-        typedef std::shared_ptr<LabelStatement> Ref; 
-    };
-    struct ReturnStatement : public Statement
+    }
+    // one line of a TAC listing, format spells the operands
+    template <typename Format>
+    void print_statement(std::ostream& out, const Statement& statement, Format format)
     {
-        Operand::Ref ret_val; 
-
-        ReturnStatement(Operand::Ref ret_val) : Statement(StatementType::Return), ret_val(ret_val)
+        switch (statement.type)
         {
+            case StatementType::Goto:
+                out << "goto " << format(statement.dst) << "\n";
+                break;
+            case StatementType::Condition:
+                out << "if (" << format(statement.lhs) << " != " << statement.rhs.value << ") goto " << format(statement.dst) << "\n";
+                break;
+            case StatementType::Assign:
+                out << format(statement.dst) << " = " << format(statement.rhs) << "\n"; 
+                break;
+            case StatementType::Triple:
+                out << format(statement.dst) << " = " << op_code_symbol(statement.op) << format(statement.rhs) << "\n";
+                break;
+            case StatementType::Quad:
+                out << format(statement.dst) << " = " << format(statement.lhs) 
+                    << " " << op_code_symbol(statement.op) << " " << format(statement.rhs) << "\n"; 
+                break;
+            case StatementType::Label:
+                out << format(statement.dst) << ":\n";
+                break;
+            case StatementType::Return:
+                out << "RET " << format(statement.rhs) << "\n"; 
+                break;
         }
-
-        typedef std::shared_ptr<ReturnStatement> Ref; 
+    }
+    // labels are numbered from 0 and spelled from L1 on, in listings and
+    // assembly alike
+    static inline std::string label_name(uint32_t id)
+    {
+        return "L" + std::to_string(id + 1); 
+    }
+    // a variable declared in the function
+    struct Variable
+    {
+        StringId name; 
+        uint32_t byte_size; 
     };
     struct Function 
     {
-        std::string function_name;
-        std::vector<Statement::Ref> statements{};
-        size_t label_counter = 0, temp_counter = 0; 
+        StringId function_name;
+        std::vector<Statement> statements{};
+        // what Operand::id() indexes for variables and temps
+        std::vector<Variable> variables{}; 
+        // temps are numbered from 0; their live ranges come from liveness
+        uint32_t temp_count = 0; 
+        // index of the Label statement placing each label, so that jumps
+        // resolve without a search
+        std::vector<uint32_t> label_positions{}; 
 
-        Function(const std::string& function_name) : function_name(function_name)
+        Function(StringId function_name) : function_name(function_name)
         {
         }
 
-        typedef std::shared_ptr<Function> Ref; 
+        uint32_t position_of(Operand label) const { return label_positions[label.id()]; }
+
+        // a function is owned by one phase at a time and handed on by moving
+        typedef std::unique_ptr<Function> Ref; 
+    };
+    // output of the TAC phase; move-only, the code generator takes it over
+    struct Program
+    {
+        std::vector<Function::Ref> functions; 
     };
 };
\ No newline at end of file
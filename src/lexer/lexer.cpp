@@ -1,341 +1,268 @@
 #include "lexer.hpp"
 
-static Token& parse_keyword(Token& token)
+static inline CharClass char_class(char c)
 {
-    if (token.value == "int")      token.kind = TokenKind::Int;
-    if (token.value == "if")       token.kind = TokenKind::If;
-    if (token.value == "else")     token.kind = TokenKind::Else;
-    if (token.value == "do")       token.kind = TokenKind::Do;
-    if (token.value == "for")      token.kind = TokenKind::For;
-    if (token.value == "while")    token.kind = TokenKind::While;
-    if (token.value == "break")    token.kind = TokenKind::Break;
-    if (token.value == "continue") token.kind = TokenKind::Continue;
-    if (token.value == "return")   token.kind = TokenKind::Return;
-    if (token.kind != TokenKind::Identifier) 
-        token.value.clear();
-    return token;
+    return CHAR_CLASSES[(unsigned char) c]; 
 }
 
-const std::vector<Token>& Lexer::LexFile(const std::string& filepath)
+// index of the first character at or after start that fails predicate
+template<typename Predicate>
+static inline size_t scan_while(std::string_view input, size_t start, Predicate predicate)
 {
-    std::ifstream lexfile;
-    lexfile.open(filepath);
-    if (lexfile.is_open())
+    size_t i = start; 
+    while (i < input.length() && predicate(input[i]))
+        i++; 
+    return i; 
+}
+
+bool Lexer::OpenSource(const std::string& filepath)
+{
+    m_Lines.clear(); 
+    if (!m_Source.Open(filepath))
     {
-        std::stringstream buffer;
-        buffer << lexfile.rdbuf();
-        const std::string& file_content = buffer.str();
-        std::string_view view{ file_content}; 
-        StackString str{ view }; 
-        while (str.hasCapacity())
+        LOG(Lexer, Error) << "Could not open lex file @ " << filepath << "!" << std::endl;
+        return false; 
+    }
+    // tokens address the source with 32-bit offsets
+    if (m_Source.view().length() > UINT32_MAX)
+        throw std::runtime_error("error: Source file '" + filepath + "' is larger than 4 GiB"); 
+    return true; 
+}
+
+const TokenList& Lexer::LexFile(const std::string& filepath)
+{
+    if (OpenSource(filepath))
+    {
+        auto source = m_Source.view(); 
+        auto bounds = SplitChunks(source, std::thread::hardware_concurrency()); 
+        m_Tokens = bounds.size() > 2 ? LexChunks(source, bounds) : LexRange(source, 0, source.length()); 
+    }
+    return m_Tokens; 
+}
+
+TokenStream Lexer::StreamFile(const std::string& filepath)
+{
+    if (OpenSource(filepath))
+    {
+        // large inputs are lexed up front in parallel and the stream just
+        // walks the finished token list
+        auto bounds = SplitChunks(m_Source.view(), std::thread::hardware_concurrency()); 
+        if (bounds.size() > 2)
         {
-            auto token = LexToken(str); 
-            if (token.kind != TokenKind::None && token.kind != TokenKind::Comment && token.kind != TokenKind::MultilineComment)
-                m_Tokens.emplace_back(token); 
+            m_Tokens = LexChunks(m_Source.view(), bounds); 
+            return TokenStream(*this, m_Tokens); 
         }
-    } else std::cout << "Could not open lex file @ " << filepath << "!" << std::endl;
-    return m_Tokens; 
+    }
+    return TokenStream(*this, m_Source.view()); 
 }
 
-Token Lexer::LexToken(StackString& str)
+TokenList Lexer::LexRange(std::string_view source, size_t begin, size_t end)
 {
-    Token token{ TokenKind::None, 0, 0 };
+    TokenList tokens{ source }; 
+    StackString str{ source.substr(0, end), begin }; 
     while (str.hasCapacity())
     {
-        char next_char = str.peek();
-        if (token.kind == TokenKind::None)
+        auto token = LexToken(str); 
+        if (token.kind != TokenKind::None)
+            tokens.push_back(token); 
+    }
+    return tokens; 
+}
+
+std::vector<size_t> Lexer::SplitChunks(std::string_view source, size_t threads) const
+{
+    std::vector<size_t> bounds{ 0 }; 
+    if (source.length() < PARALLEL_LEX_THRESHOLD || threads < 2)
+    {
+        bounds.emplace_back(source.length()); 
+        return bounds; 
+    }
+
+    // a few chunks per thread so an unlucky chunk does not hold up the rest
+    size_t count = std::min(threads * 4, source.length() / MIN_CHUNK_SIZE); 
+    for (size_t i = 1; i < count; i++)
+    {
+        size_t bound = find_newline(source, source.length() / count * i) + 1; 
+        if (bound > bounds.back() && bound < source.length())
+            bounds.emplace_back(bound); 
+    }
+
+    // a line start can still be inside a block comment, so walk the comments
+    // once and push any boundary that lands in one to the end of the comment
+    size_t next = 1; 
+    for (size_t i = source.find('/'); i != std::string_view::npos && next < bounds.size(); i = source.find('/', i))
+    {
+        if (i + 1 < source.length() && source[i + 1] == '/')
+            i = find_newline(source, i + 2); 
+        else if (i + 1 < source.length() && source[i + 1] == '*')
         {
-            token.line = str.line(); 
-            token.position = str.line_position(); 
+            size_t end = std::min(find_comment_end(source, i + 2) + 2, source.length()); 
+            for (; next < bounds.size() && bounds[next] < end; next++)
+                if (bounds[next] > i) bounds[next] = end; 
+            i = end; 
+        } else i++; 
+    }
 
-            if (is_nondigit(next_char))
-            {
-                token.kind = TokenKind::Identifier;
-                continue;
-            }
+    bounds.emplace_back(source.length()); 
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end()); 
+    return bounds; 
+}
 
-            if (is_digit(next_char))
+TokenList Lexer::LexChunks(std::string_view source, const std::vector<size_t>& bounds)
+{
+    size_t count = bounds.size() - 1; 
+    std::vector<TokenList> results(count); 
+    std::vector<std::exception_ptr> errors(count); 
+    std::atomic<size_t> next{ 0 }; 
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            try
             {
-                token.kind = TokenKind::IntConstant;
-                continue;
+                results[i] = LexRange(source, bounds[i], bounds[i + 1]); 
+            } catch (...) {
+                errors[i] = std::current_exception(); 
             }
+        }
+    };
 
-            if (str.hasCapacity(3))
-            {
-                auto charSequence = str.peek(3); 
-                if (charSequence == "<<=")
-                {
-                    auto token = CreateToken(TokenKind::LeftShiftEquals, str); 
-                    str.pop(3);
-                    return token; 
-                } else if (charSequence == ">>=")
-                {
-                    auto token = CreateToken(TokenKind::RightShiftEquals, str);
-                    str.pop(3);
-                    return token;
-                }
-            }
+    std::vector<std::thread> pool; 
+    size_t threads = std::min<size_t>(std::thread::hardware_concurrency(), count); 
+    for (size_t i = 0; i < threads; i++)
+        pool.emplace_back(worker); 
+    for (auto& thread : pool)
+        thread.join(); 
 
-            if (str.hasCapacity(2))
-            {
-                auto charSequence = str.peek(2); 
-                if (charSequence == "0x")
-                {
-                    token.kind = TokenKind::HexConstant;
-                    token.value += str.pop(2);
-                    continue;
-                } else if (charSequence == "//")
-                {
-                    str.pop(2); 
-                    token.kind = TokenKind::Comment; 
-                    continue;
-                } else if (charSequence == "/*")
-                {
-                    str.pop(2); 
-                    token.kind = TokenKind::MultilineComment; 
-                    continue; 
-                } else if (charSequence == "&&")
-                {
-                    auto token = CreateToken(TokenKind::DoubleAmpersand, str);
-                    str.pop(2); 
-                    return token;
-                } else if (charSequence == "||")
-                {
-                    auto token = CreateToken(TokenKind::DoublePipe, str);
-                    str.pop(2); 
-                    return token;
-                } else if (charSequence == "==")
-                {
-                    auto token = CreateToken(TokenKind::DoubleEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "!=")
-                {
-                    auto token = CreateToken(TokenKind::NotEqual, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "<=")
-                {
-                    auto token = CreateToken(TokenKind::LessThanOrEqual, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == ">=")
-                {
-                    auto token = CreateToken(TokenKind::GreaterThanOrEqual, str);
-                    str.pop(2); 
-                    return token;
-                } else if (charSequence == "<<")
-                {
-                    auto token = CreateToken(TokenKind::LeftShift, str);
-                    str.pop(2);
-                    return token; 
-                } else if (charSequence == ">>")
-                {
-                    auto token = CreateToken(TokenKind::RightShift, str);
-                    str.pop(2);
-                    return token; 
-                } else if (charSequence == "+=")
-                {
-                    auto token = CreateToken(TokenKind::AddEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "-=")
-                {
-                    auto token = CreateToken(TokenKind::MinusEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "*=")
-                {
-                    auto token = CreateToken(TokenKind::AsteriskEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "/=")
-                {
-                    auto token = CreateToken(TokenKind::SlashEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "%=")
-                {
-                    auto token = CreateToken(TokenKind::PercentEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "<<=")
-                {
-                    auto token = CreateToken(TokenKind::LeftShiftEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == ">>=")
-                {
-                    auto token = CreateToken(TokenKind::RightShiftEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "|=")
-                {
-                    auto token = CreateToken(TokenKind::OrEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "&=")
-                {
-                    auto token = CreateToken(TokenKind::AddEquals, str);
-                    str.pop(2); 
-                    return token;
-                } else if (charSequence == "^=")
-                {
-                    auto token = CreateToken(TokenKind::CaretEquals, str);
-                    str.pop(2);
-                    return token;
-                } else if (charSequence == "++")
-                {
-                    auto token = CreateToken(TokenKind::PlusPlus, str);
-                    str.pop(2);
-                    return token; 
-                } else if (charSequence == "--")
-                {
-                    auto token = CreateToken(TokenKind::MinusMinus, str);
-                    str.pop(2);
-                    return token;
-                }
-            }
+    // report the error a serial lex would have hit first
+    for (auto& error : errors)
+        if (error) std::rethrow_exception(error); 
+
+    size_t total = 0; 
+    for (auto& result : results)
+        total += result.size(); 
+    TokenList tokens{ source }; 
+    tokens.reserve(total); 
+    for (auto& result : results)
+        tokens.append(result); 
+    return tokens; 
+}
+
+void Lexer::ExceptLex(const std::string& msg, size_t offset)
+{
+    auto location = Locate(static_cast<uint32_t>(offset)); 
+    throw std::runtime_error(std::to_string(location.line) + ":" + std::to_string(location.column) + ": " + msg); 
+}
 
-            switch (next_char)
+SourceLocation Lexer::Locate(uint32_t offset)
+{
+    // chunks lexed in parallel can fail at the same time
+    std::lock_guard<std::mutex> lock(m_LinesMutex); 
+    if (m_Lines.empty()) m_Lines.Build(m_Source.view()); 
+    return m_Lines.Locate(offset); 
+}
+
+Token Lexer::LexToken(StackString& str)
+{
+    auto input = str.remaining(); 
+    // whitespace and comments are skipped here and never become tokens
+    size_t start = 0; 
+    while (start < input.length())
+    {
+        if (char_class(input[start]) == CharClass::Whitespace)
+        {
+            start = skip_whitespace(input, start + 1); 
+            continue; 
+        }
+        if (input[start] != '/' || start + 1 == input.length()) break; 
+        if (input[start + 1] == '/')
+            start = find_newline(input, start + 2); 
+        else if (input[start + 1] == '*')
+            start = std::min(find_comment_end(input, start + 2) + 2, input.length()); 
+        else break; 
+    }
+    if (start > 0)
+    {
+        str.pop(start); 
+        input.remove_prefix(start); 
+    }
+
+    Token token{ TokenKind::None, static_cast<uint32_t>(str.position()) };
+    if (input.empty()) return token; 
+
+    // characters the lexer does not know are skipped one at a time
+    size_t length = 1; 
+    switch (char_class(input[0]))
+    {
+        case CharClass::Letter:
+        {
+            length = scan_while(input, 1, [](char c) 
+            { 
+                auto cls = char_class(c); 
+                return cls == CharClass::Letter || cls == CharClass::Digit; 
+            });
+            token.value = input.substr(0, length); 
+            token.kind = KEYWORD_TABLE.find(token.value); 
+            if (token.kind != TokenKind::Identifier)
+                token.value = std::string_view(); 
+            break;
+        }
+        case CharClass::Digit:
+        {
+            // decode the literal while scanning it; anything that does not fit
+            // the 32 bits of an int is rejected rather than silently truncated
+            auto digit_value = [](char c) { return DIGIT_VALUES[(unsigned char) c]; }; 
+            unsigned base = 10; 
+            length = 0; 
+            token.kind = TokenKind::IntConstant; 
+            if (input[0] == '0')
             {
-                case '(':
-                    token.kind = TokenKind::LeftParenthesis; 
-                    break;
-                case ')':
-                    token.kind = TokenKind::RightParenthesis; 
-                    break;
-                case '{':
-                    token.kind = TokenKind::LeftBrace;
-                    break;
-                case '}':
-                    token.kind = TokenKind::RightBrace;
-                    break;
-                case ':':
-                    token.kind = TokenKind::Colon;
-                    break;
-                case ';':
-                    token.kind = TokenKind::Semicolon;
-                    break;
-                case '-':
-                    token.kind = TokenKind::Minus;
-                    break;
-                case '~':
-                    token.kind = TokenKind::Tilde;
-                    break; 
-                case '!':
-                    token.kind = TokenKind::Exclamation; 
-                    break;
-                case '+':
-                    token.kind = TokenKind::Plus;
-                    break; 
-                case '*':
-                    token.kind = TokenKind::Asterisk;
-                    break;
-                case '/':
-                    token.kind = TokenKind::Slash;
-                    break; 
-                case '&':
-                    token.kind = TokenKind::Ampersand;
-                    break;
-                case '|':
-                    token.kind = TokenKind::Pipe;
-                    break;
-                case '<':
-                    token.kind = TokenKind::LessThan;
-                    break;
-                case '>':
-                    token.kind = TokenKind::GreaterThan;
-                    break;
-                case '%':
-                    token.kind = TokenKind::Percent;
-                    break; 
-                case '^':
-                    token.kind = TokenKind::Caret;
-                    break; 
-                case '=':
-                    token.kind = TokenKind::Equal;
-                    break;
-                case ',':
-                    token.kind = TokenKind::Comma;
-                    break;
-                case '?':
-                    token.kind = TokenKind::QuestionMark;
-                    break;
+                if (input.length() > 2 && (input[1] == 'x' || input[1] == 'X') && digit_value(input[2]) < 16)
+                {
+                    base = 16; 
+                    length = 2; 
+                    token.kind = TokenKind::HexConstant; 
+                } else base = 8; 
             }
-
-            if (token.kind != TokenKind::None)
+            uint64_t value = 0; 
+            for (; length < input.length(); length++)
             {
-                str.pop(); 
-                return token;
+                unsigned digit = digit_value(input[length]); 
+                if (digit >= std::max(base, 10u)) break; 
+                if (digit >= base)
+                    ExceptLex("error: Invalid digit '" + std::string(1, input[length]) + "' in octal constant", str.position() + length); 
+                // saturate just past UINT32_MAX so long literals cannot wrap around
+                value = std::min<uint64_t>(value * base + digit, UINT64_C(1) << 32); 
             }
+            if (value > UINT32_MAX)
+                ExceptLex("error: Integer constant '" + std::string(input.substr(0, length)) + "' is too large", str.position()); 
+            token.value = input.substr(0, length); 
+            token.constant = static_cast<uint32_t>(value); 
+            break;
         }
-        else
+        case CharClass::Punctuator:
         {
-            switch (token.kind)
+            // walk the DFA as far as it goes, remembering the last accepting state
+            size_t state = 0, i = 0; 
+            length = 0; 
+            while (i < input.length())
             {
-                case TokenKind::Identifier:
-                    if (is_nondigit(next_char) || is_digit(next_char))
-                        token.value += next_char;
-                    else return parse_keyword(token); 
-                    break; 
-                case TokenKind::IntConstant:
-                    if (is_digit(next_char))
-                        token.value += next_char;
-                    else return token; 
-                    break;
-                case TokenKind::HexConstant:
-                    if (is_hexdigit(next_char))
-                        token.value += next_char;
-                    else return token;
-                    break; 
-                case TokenKind::Comment:
-                    if (next_char == '\n')
-                    {
-                        std::cout << "Comment: " << token.value << std::endl;
-                        str.pop(); 
-                        return token; 
-                    } 
-                    token.value += str.pop(); 
-                    continue;
-                case TokenKind::MultilineComment:
-                    if (str.hasCapacity(2) && str.peek(2) == "*/")
-                    {
-                        str.pop(2);
-                        return token; 
-                    }
-                    token.value += str.pop(); 
-                    continue;
+                state = PUNCTUATOR_DFA.transitions[state][(unsigned char) input[i]]; 
+                if (state == 0) break; 
+                i++; 
+                if (PUNCTUATOR_DFA.accept[state] != TokenKind::None)
+                {
+                    token.kind = PUNCTUATOR_DFA.accept[state]; 
+                    length = i; 
+                }
             }
 
-            switch (next_char)
-            {
-                case '(': 
-                case ')':
-                case '{':
-                case '}':
-                case ':':
-                case ';':
-                case '-':
-                case '~':
-                case '!':
-                case '+':
-                case '*':
-                case '/':
-                case '&':
-                case '|':
-                case '=':
-                case '<':
-                case '>':
-                case '%':
-                case '^': 
-                case ',':
-                case '?':
-                    return token; 
-            }
+            break;
         }
-
-        str.pop();
+        default:
+            break;
     }
+
+    str.pop(length); 
     return token; 
-}
\ No newline at end of file
+}
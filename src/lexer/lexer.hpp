@@ -1,15 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <ctype.h>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "compiler/log.hpp"
+#include "line_index.hpp"
+#include "scan_tables.hpp"
+#include "simd_scan.hpp"
+#include "source_buffer.hpp"
 #include "token.hpp"
+#include "token_list.hpp"
+#include "token_stream.hpp"
 #include "stack_str.hpp"
-#include "utility.hpp"
 
 class Lexer
 {
@@ -17,14 +29,40 @@ class Lexer
         Lexer() = default; 
         virtual ~Lexer() = default; 
 
-        virtual const std::vector<Token>& LexFile(const std::string& filepath); 
+        // inputs of at least this size are split into chunks lexed in parallel
+        static constexpr size_t PARALLEL_LEX_THRESHOLD = 4 << 20; 
+        static constexpr size_t MIN_CHUNK_SIZE = 256 << 10; 
+
+        // lex the whole file up front
+        virtual const TokenList& LexFile(const std::string& filepath); 
+        // lex the file lazily as the consumer pulls tokens, unless it is large
+        // enough to be worth lexing up front in parallel
+        virtual TokenStream StreamFile(const std::string& filepath); 
         virtual Token LexToken(StackString& str); 
 
+        // line and column of a token offset in the current file
+        SourceLocation Locate(uint32_t offset); 
+
+        // identifiers of every file lexed by this lexer
+        StringInterner& Interner() { return m_Interner; }
+        StringId Intern(std::string_view text) { return m_Interner.Intern(text); }
+
     protected:
-        std::vector<Token> m_Tokens; 
+        // source text of the current file, kept alive for the whole compilation
+        // since token values are views into it
+        SourceBuffer m_Source; 
+        // built on the first call to Locate
+        LineIndex m_Lines; 
+        std::mutex m_LinesMutex; 
+        TokenList m_Tokens; 
+        StringInterner m_Interner; 
 
-        inline static Token CreateToken(TokenKind kind, const StackString& str)
-        {
-            return Token(kind, str.line_position(), str.line()); 
-        }
+        bool OpenSource(const std::string& filepath); 
+        TokenList LexRange(std::string_view source, size_t begin, size_t end); 
+        // offsets splitting source into chunks for threads to lex, that start
+        // at a line start or right after a block comment, first 0 and last
+        // source.length()
+        std::vector<size_t> SplitChunks(std::string_view source, size_t threads) const; 
+        TokenList LexChunks(std::string_view source, const std::vector<size_t>& bounds); 
+        [[noreturn]] void ExceptLex(const std::string& msg, size_t offset); 
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+struct SourceLocation
+{
+    size_t line, column; 
+};
+
+// Offsets of every line start in a source buffer. Tokens only carry their
+// byte offset; the index is built the first time a diagnostic needs a
+// line and column and turns offsets back into them with a binary search.
+class LineIndex
+{
+    public:
+        bool empty() const { return m_LineStarts.empty(); }
+        void clear() { m_LineStarts.clear(); }
+
+        void Build(std::string_view source)
+        {
+            m_LineStarts.clear(); 
+            m_LineStarts.emplace_back(0); 
+            for (size_t i = source.find('\n'); i != std::string_view::npos; i = source.find('\n', i + 1))
+                m_LineStarts.emplace_back(static_cast<uint32_t>(i + 1)); 
+        }
+
+        // 1-based line and column of offset
+        SourceLocation Locate(uint32_t offset) const
+        {
+            auto next = std::upper_bound(m_LineStarts.begin(), m_LineStarts.end(), offset); 
+            size_t line = next - m_LineStarts.begin(); 
+            return SourceLocation{ line, offset - *(next - 1) + 1 }; 
+        }
+
+    private:
+        std::vector<uint32_t> m_LineStarts; 
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "token_kind.hpp"
+
+// Compile-time tables driving Lexer::LexToken.
+
+enum class CharClass : uint8_t
+{
+    Other,
+    Whitespace,
+    Letter,
+    Digit,
+    Punctuator
+};
+
+struct Punctuator
+{
+    std::string_view spelling; 
+    TokenKind kind; 
+};
+
+// every operator/delimiter the lexer recognizes; comments are skipped along
+// with whitespace before the DFA runs
+static constexpr Punctuator PUNCTUATORS[] =
+{
+    { "(",   TokenKind::LeftParenthesis    },
+    { ")",   TokenKind::RightParenthesis   },
+    { "{",   TokenKind::LeftBrace          },
+    { "}",   TokenKind::RightBrace         },
+    { ":",   TokenKind::Colon              },
+    { ";",   TokenKind::Semicolon          },
+    { ",",   TokenKind::Comma              },
+    { "?",   TokenKind::QuestionMark       },
+    { "~",   TokenKind::Tilde              },
+    { "!",   TokenKind::Exclamation        },
+    { "!=",  TokenKind::NotEqual           },
+    { "+",   TokenKind::Plus               },
+    { "++",  TokenKind::PlusPlus           },
+    { "+=",  TokenKind::AddEquals          },
+    { "-",   TokenKind::Minus              },
+    { "--",  TokenKind::MinusMinus         },
+    { "-=",  TokenKind::MinusEquals        },
+    { "*",   TokenKind::Asterisk           },
+    { "*=",  TokenKind::AsteriskEquals     },
+    { "/",   TokenKind::Slash              },
+    { "/=",  TokenKind::SlashEquals        },
+    { "%",   TokenKind::Percent            },
+    { "%=",  TokenKind::PercentEquals      },
+    { "&",   TokenKind::Ampersand          },
+    { "&&",  TokenKind::DoubleAmpersand    },
+    { "&=",  TokenKind::AndEquals          },
+    { "|",   TokenKind::Pipe               },
+    { "||",  TokenKind::DoublePipe         },
+    { "|=",  TokenKind::OrEquals           },
+    { "^",   TokenKind::Caret              },
+    { "^=",  TokenKind::CaretEquals        },
+    { "=",   TokenKind::Equal              },
+    { "==",  TokenKind::DoubleEquals       },
+    { "<",   TokenKind::LessThan           },
+    { "<=",  TokenKind::LessThanOrEqual    },
+    { "<<",  TokenKind::LeftShift          },
+    { "<<=", TokenKind::LeftShiftEquals    },
+    { ">",   TokenKind::GreaterThan        },
+    { ">=",  TokenKind::GreaterThanOrEqual },
+    { ">>",  TokenKind::RightShift         },
+    { ">>=", TokenKind::RightShiftEquals   }
+};
+
+static constexpr std::array<CharClass, 256> build_char_classes()
+{
+    std::array<CharClass, 256> classes{}; 
+    for (auto c : std::string_view(" \t\n\v\f\r"))
+        classes[(unsigned char) c] = CharClass::Whitespace; 
+    for (int c = 'a'; c <= 'z'; c++) classes[c] = CharClass::Letter; 
+    for (int c = 'A'; c <= 'Z'; c++) classes[c] = CharClass::Letter; 
+    classes['_'] = CharClass::Letter; 
+    for (int c = '0'; c <= '9'; c++) classes[c] = CharClass::Digit; 
+    for (auto& punctuator : PUNCTUATORS)
+        classes[(unsigned char) punctuator.spelling[0]] = CharClass::Punctuator; 
+    return classes; 
+}
+
+static constexpr std::array<CharClass, 256> CHAR_CLASSES = build_char_classes(); 
+
+// value of a digit in bases up to 16, or 0xFF for any other character
+static constexpr std::array<uint8_t, 256> build_digit_values()
+{
+    std::array<uint8_t, 256> values{}; 
+    for (auto& value : values) value = 0xFF; 
+    for (int c = '0'; c <= '9'; c++) values[c] = c - '0'; 
+    for (int c = 'a'; c <= 'f'; c++) values[c] = c - 'a' + 10; 
+    for (int c = 'A'; c <= 'F'; c++) values[c] = c - 'A' + 10; 
+    return values; 
+}
+
+static constexpr std::array<uint8_t, 256> DIGIT_VALUES = build_digit_values(); 
+
+// Maximal-munch DFA over PUNCTUATORS. State 0 is the start state and doubles
+// as the dead state, since no transition ever leads back into it.
+struct PunctuatorDFA
+{
+    static constexpr size_t MAX_STATES = 64; 
+
+    uint8_t transitions[MAX_STATES][256]{}; 
+    TokenKind accept[MAX_STATES]{}; 
+    size_t state_count = 1; 
+};
+
+static constexpr PunctuatorDFA build_punctuator_dfa()
+{
+    PunctuatorDFA dfa{}; 
+    for (auto& state : dfa.accept)
+        state = TokenKind::None; 
+    for (auto& punctuator : PUNCTUATORS)
+    {
+        size_t state = 0; 
+        for (auto c : punctuator.spelling)
+        {
+            auto& next = dfa.transitions[state][(unsigned char) c]; 
+            if (next == 0) next = dfa.state_count++; 
+            state = next; 
+        }
+        dfa.accept[state] = punctuator.kind; 
+    }
+    return dfa; 
+}
+
+static constexpr PunctuatorDFA PUNCTUATOR_DFA = build_punctuator_dfa(); 
+static_assert(PUNCTUATOR_DFA.state_count <= PunctuatorDFA::MAX_STATES, "punctuator DFA exceeds MAX_STATES"); 
+
+// Perfect hash over KEYWORDS. The hash mixes a key built from the first,
+// second and last character and the length with a seed; the first seed that
+// sends every keyword to its own slot is found at compile time, so lookup is
+// one hash and one string compare.
+static constexpr size_t keyword_table_bits()
+{
+    // keep the table at most a quarter full so a seed is found quickly
+    size_t bits = 1; 
+    while ((size_t(1) << bits) < (sizeof(KEYWORDS) / sizeof(Keyword)) * 4)
+        bits++; 
+    return bits; 
+}
+
+struct KeywordTable
+{
+    static constexpr size_t BITS = keyword_table_bits(); 
+    static constexpr size_t SIZE = size_t(1) << BITS; 
+
+    Keyword slots[SIZE]{}; 
+    uint32_t seed = 0; 
+    size_t min_length = ~size_t(0), max_length = 0; 
+
+    static constexpr uint32_t hash(std::string_view str, uint32_t seed)
+    {
+        uint32_t key = (uint32_t) (unsigned char) str[0] | 
+            (uint32_t) (unsigned char) str[1] << 8 |
+            (uint32_t) (unsigned char) str[str.length() - 1] << 16 | 
+            (uint32_t) str.length() << 24; 
+        uint32_t x = (key ^ seed) * 0x9E3779B1u; 
+        x ^= x >> 15; 
+        x *= 0x85EBCA6Bu; 
+        return x >> (32 - BITS); 
+    }
+
+    constexpr TokenKind find(std::string_view str) const
+    {
+        if (str.length() < min_length || str.length() > max_length)
+            return TokenKind::Identifier; 
+        auto& slot = slots[hash(str, seed)]; 
+        return slot.spelling == str ? slot.kind : TokenKind::Identifier; 
+    }
+};
+
+static constexpr KeywordTable build_keyword_table()
+{
+    KeywordTable table{}; 
+    for (auto& keyword : KEYWORDS)
+    {
+        if (keyword.spelling.length() < table.min_length) table.min_length = keyword.spelling.length(); 
+        if (keyword.spelling.length() > table.max_length) table.max_length = keyword.spelling.length(); 
+    }
+    for (uint32_t seed = 1; seed < 1u << 16; seed++)
+    {
+        bool used[KeywordTable::SIZE]{}; 
+        bool collision = false; 
+        for (auto& keyword : KEYWORDS)
+        {
+            auto slot = KeywordTable::hash(keyword.spelling, seed); 
+            if (used[slot])
+            {
+                collision = true; 
+                break; 
+            }
+            used[slot] = true; 
+        }
+        if (collision) continue; 
+
+        table.seed = seed; 
+        for (auto& slot : table.slots)
+            slot = Keyword{ std::string_view(), TokenKind::Identifier }; 
+        for (auto& keyword : KEYWORDS)
+            table.slots[KeywordTable::hash(keyword.spelling, seed)] = keyword; 
+        return table; 
+    }
+    return table; 
+}
+
+static constexpr KeywordTable KEYWORD_TABLE = build_keyword_table(); 
+static_assert(KEYWORD_TABLE.seed != 0, "no perfect hash seed found for KEYWORDS"); 
+static_assert(KEYWORD_TABLE.min_length >= 2, "keyword hash reads the second character"); 
+
+static constexpr bool keyword_table_complete()
+{
+    for (auto& keyword : KEYWORDS)
+        if (KEYWORD_TABLE.find(keyword.spelling) != keyword.kind) return false; 
+    return true; 
+}
+static_assert(keyword_table_complete(), "keyword hash table is missing a keyword"); 
@@ -0,0 +1,179 @@
+#include "simd_scan.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAS_AVX2_DISPATCH
+#endif
+
+static inline bool is_whitespace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r'); 
+}
+
+static size_t skip_whitespace_scalar(std::string_view input, size_t i)
+{
+    while (i < input.length() && is_whitespace(input[i]))
+        i++; 
+    return i; 
+}
+
+static size_t find_newline_scalar(std::string_view input, size_t i)
+{
+    while (i < input.length() && input[i] != '\n')
+        i++; 
+    return i; 
+}
+
+static size_t find_comment_end_scalar(std::string_view input, size_t i)
+{
+    for (; i + 1 < input.length(); i++)
+        if (input[i] == '*' && input[i + 1] == '/') return i; 
+    return input.length(); 
+}
+
+#if defined(__SSE2__)
+// whitespace is ' ' or '\t'..'\r'; the signed compares leave bytes >= 0x80 out
+static inline __m128i whitespace_mask_sse2(__m128i chunk)
+{
+    auto space = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')); 
+    auto control = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('\t' - 1)), 
+        _mm_cmplt_epi8(chunk, _mm_set1_epi8('\r' + 1))); 
+    return _mm_or_si128(space, control); 
+}
+
+static size_t skip_whitespace_sse2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    for (; i + 16 <= input.length(); i += 16)
+    {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)); 
+        unsigned mask = ~_mm_movemask_epi8(whitespace_mask_sse2(chunk)) & 0xFFFF; 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return skip_whitespace_scalar(input, i); 
+}
+
+static size_t find_newline_sse2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    auto newline = _mm_set1_epi8('\n'); 
+    for (; i + 16 <= input.length(); i += 16)
+    {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)); 
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)); 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return find_newline_scalar(input, i); 
+}
+
+static size_t find_comment_end_sse2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    auto star = _mm_set1_epi8('*'), slash = _mm_set1_epi8('/'); 
+    // compare the block against '*' and the block one byte later against '/'
+    for (; i + 17 <= input.length(); i += 16)
+    {
+        auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)); 
+        auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1)); 
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, star), _mm_cmpeq_epi8(second, slash))); 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return find_comment_end_scalar(input, i); 
+}
+#endif
+
+#if defined(HAS_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+static size_t skip_whitespace_avx2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    auto space = _mm256_set1_epi8(' '); 
+    auto low = _mm256_set1_epi8('\t' - 1), high = _mm256_set1_epi8('\r' + 1); 
+    for (; i + 32 <= input.length(); i += 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)); 
+        auto control = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, low), _mm256_cmpgt_epi8(high, chunk)); 
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), control))); 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return skip_whitespace_scalar(input, i); 
+}
+
+__attribute__((target("avx2")))
+static size_t find_newline_avx2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    auto newline = _mm256_set1_epi8('\n'); 
+    for (; i + 32 <= input.length(); i += 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)); 
+        unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline)); 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return find_newline_scalar(input, i); 
+}
+
+__attribute__((target("avx2")))
+static size_t find_comment_end_avx2(std::string_view input, size_t i)
+{
+    const char* data = input.data(); 
+    auto star = _mm256_set1_epi8('*'), slash = _mm256_set1_epi8('/'); 
+    for (; i + 33 <= input.length(); i += 32)
+    {
+        auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)); 
+        auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 1)); 
+        unsigned mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, star), _mm256_cmpeq_epi8(second, slash))); 
+        if (mask) return i + __builtin_ctz(mask); 
+    }
+    return find_comment_end_scalar(input, i); 
+}
+
+static bool cpu_has_avx2()
+{
+    static const bool has_avx2 = []
+    {
+        __builtin_cpu_init(); 
+        return __builtin_cpu_supports("avx2") != 0; 
+    }(); 
+    return has_avx2; 
+}
+#endif
+
+size_t skip_whitespace(std::string_view input, size_t start)
+{
+#if defined(HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2()) return skip_whitespace_avx2(input, start); 
+#endif
+#if defined(__SSE2__)
+    return skip_whitespace_sse2(input, start); 
+#else
+    return skip_whitespace_scalar(input, start); 
+#endif
+}
+
+size_t find_newline(std::string_view input, size_t start)
+{
+#if defined(HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2()) return find_newline_avx2(input, start); 
+#endif
+#if defined(__SSE2__)
+    return find_newline_sse2(input, start); 
+#else
+    return find_newline_scalar(input, start); 
+#endif
+}
+
+size_t find_comment_end(std::string_view input, size_t start)
+{
+#if defined(HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2()) return find_comment_end_avx2(input, start); 
+#endif
+#if defined(__SSE2__)
+    return find_comment_end_sse2(input, start); 
+#else
+    return find_comment_end_scalar(input, start); 
+#endif
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Vectorized scanners for the parts of the input the lexer throws away.
+// Each returns an index into input, or input.length() when the scan runs
+// off the end. Blocks of 32 bytes are compared with AVX2 when the CPU has
+// it, 16 bytes with SSE2 otherwise, and the tail is finished scalar.
+
+// first character at or after start that is not whitespace
+size_t skip_whitespace(std::string_view input, size_t start); 
+// first '\n' at or after start
+size_t find_newline(std::string_view input, size_t start); 
+// first "*/" starting at or after start
+size_t find_comment_end(std::string_view input, size_t start); 
@@ -0,0 +1,71 @@
+#include "source_buffer.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::~SourceBuffer()
+{
+    Close(); 
+}
+
+bool SourceBuffer::Open(const std::string& filepath)
+{
+    Close(); 
+    if (filepath == "-")
+        return ReadDescriptor(STDIN_FILENO); 
+
+    int fd = open(filepath.c_str(), O_RDONLY); 
+    if (fd < 0) return false; 
+
+    struct stat st; 
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    bool success = true; 
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); 
+        if (addr != MAP_FAILED)
+        {
+            madvise(addr, st.st_size, MADV_SEQUENTIAL); 
+            m_Data = static_cast<const char*>(addr); 
+            m_Size = st.st_size; 
+            m_Mapped = true; 
+        } else success = ReadDescriptor(fd); 
+    } else if (!S_ISREG(st.st_mode)) 
+        success = ReadDescriptor(fd); 
+    // empty regular files have nothing to map
+
+    close(fd); 
+    return success; 
+}
+
+void SourceBuffer::Close()
+{
+    if (m_Mapped)
+        munmap(const_cast<char*>(m_Data), m_Size); 
+    m_Data = nullptr; 
+    m_Size = 0; 
+    m_Mapped = false; 
+    m_Buffer.clear(); 
+}
+
+bool SourceBuffer::ReadDescriptor(int fd)
+{
+    char chunk[64 * 1024]; 
+    while (true)
+    {
+        ssize_t count = read(fd, chunk, sizeof(chunk)); 
+        if (count == 0) break; 
+        if (count < 0) return false; 
+        m_Buffer.append(chunk, count); 
+    }
+    m_Data = m_Buffer.data(); 
+    m_Size = m_Buffer.size(); 
+    return true; 
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Read-only view of a source file. Regular files are memory-mapped so the
+// lexer scans the mapped pages directly; pipes, character devices and stdin
+// ("-") fall back to read() into an owned buffer.
+class SourceBuffer
+{
+    public:
+        SourceBuffer() = default; 
+        ~SourceBuffer(); 
+
+        SourceBuffer(const SourceBuffer&) = delete; 
+        SourceBuffer& operator=(const SourceBuffer&) = delete; 
+
+        bool Open(const std::string& filepath); 
+        void Close(); 
+
+        std::string_view view() const { return std::string_view(m_Data, m_Size); }
+        bool is_mapped() const { return m_Mapped; }
+
+    private:
+        const char* m_Data = nullptr; 
+        size_t m_Size = 0; 
+        bool m_Mapped = false; 
+        // backing storage when the input could not be mapped
+        std::string m_Buffer; 
+
+        bool ReadDescriptor(int fd); 
+};
@@ -21,15 +21,7 @@ char StackString::pop()
 {
     if (m_View.length() - m_Position < 1)
         throw PopException(); 
-    char c = m_View[m_Position]; 
-    m_LinePosition++;
-    if (c == '\n') 
-    {
-        m_LinePosition = 1; 
-        m_Line++; 
-    }
-    m_Position++; 
-    return c; 
+    return m_View[m_Position++]; 
 }
 
 std::string_view StackString::pop(size_t len)
@@ -37,15 +29,6 @@ std::string_view StackString::pop(size_t len)
     if (len < 1 || m_View.length() - m_Position < len)
         throw PopException(); 
     auto view = m_View.substr(m_Position, len);
-    m_LinePosition += len; 
-    for (char c : view)
-    {
-        if (c == '\n') 
-        {
-            m_LinePosition = 1; 
-            m_Line++; 
-        }
-    }
     m_Position += len; 
     return view; 
 }
@@ -67,5 +50,4 @@ std::string_view StackString::peek(size_t len) const
 void StackString::reset()
 {
     m_Position = 0; 
-    m_Line = 1; 
 }
\ No newline at end of file
@@ -23,6 +23,9 @@ class StackString
         StackString(std::string_view view) : m_View(view) 
         {
         }        
+        StackString(std::string_view view, size_t position) : m_View(view), m_Position(position)
+        {
+        }
 
         size_t getCapacity() const; 
         bool hasCapacity() const; 
@@ -34,10 +37,12 @@ class StackString
         std::string_view peek(size_t len) const;  
         void reset();
 
-        const size_t& line_position() const { return m_LinePosition; }
-        const size_t& line() const { return m_Line; }
+        // unconsumed part of the underlying buffer
+        std::string_view remaining() const { return m_View.substr(m_Position); }
+
+        const size_t& position() const { return m_Position; }
 
     private:
         std::string_view m_View; 
-        size_t m_Position = 0, m_LinePosition = 1, m_Line = 1; 
+        size_t m_Position = 0; 
 };
\ No newline at end of file
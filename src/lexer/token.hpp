@@ -1,20 +1,35 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 
 #include "token_kind.hpp"
+#include "utility/interner.hpp"
 
 struct Token
 {
     TokenKind kind;
-    std::string value{}; 
-    // metadata
-    size_t line, position; 
+    // byte offset into the lexer's source buffer, line and column are
+    // recovered from it through Lexer::Locate when a diagnostic needs them
+    uint32_t offset; 
+    // decoded value of IntConstant and HexConstant tokens
+    uint32_t constant = 0; 
+    // interned spelling of Identifier tokens, assigned as the token is
+    // handed out by the TokenStream
+    StringId id = 0; 
+    // view into the lexer's source buffer
+    std::string_view value{}; 
 
-    Token(TokenKind kind, size_t line, size_t position) : kind{kind}, value(), line(line), position(position)
+    Token() : kind(TokenKind::None), offset(0), value()
     {
     }
-    Token(TokenKind kind, const std::string& value, size_t line, size_t position) : kind(kind), value(value), line(line), position(position)
+    Token(TokenKind kind, uint32_t offset) : kind{kind}, offset(offset), value()
     {
     }
-};
\ No newline at end of file
+    Token(TokenKind kind, uint32_t offset, std::string_view value) : kind(kind), offset(offset), value(value)
+    {
+    }
+    Token(TokenKind kind, uint32_t offset, uint32_t constant) : kind(kind), offset(offset), constant(constant), value()
+    {
+    }
+};
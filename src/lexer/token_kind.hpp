@@ -1,8 +1,11 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <string_view>
 
-enum class TokenKind : int
+#include "utility/enum_table.hpp"
+
+enum class TokenKind : uint8_t
 {
     Identifier,
 
@@ -67,12 +70,19 @@ enum class TokenKind : int
     QuestionMark,
 
     // Misc.
-    Comment,
-    MultilineComment,
     None
 };
 
-static std::unordered_map<TokenKind, std::string> TOKEN_KIND_NAMES
+static constexpr size_t TOKEN_KIND_COUNT = static_cast<size_t>(TokenKind::None) + 1; 
+
+struct TokenKindName
+{
+    TokenKind key; 
+    std::string_view name; 
+};
+
+// spelling of each token kind in diagnostics, in enum order
+static constexpr TokenKindName TOKEN_KIND_NAMES[] =
 {
     { TokenKind::Identifier,         "Identifier" },
     { TokenKind::Int,                "int"        },
@@ -127,24 +137,38 @@ static std::unordered_map<TokenKind, std::string> TOKEN_KIND_NAMES
     { TokenKind::CaretEquals,        "^="         },
     { TokenKind::Comma,              ","          },
     { TokenKind::QuestionMark,       "?"          },
-    { TokenKind::Comment,            "//"         },
     { TokenKind::None,               "None"       }
 };
+static_assert(is_enum_indexed(TOKEN_KIND_NAMES, TOKEN_KIND_COUNT), "TOKEN_KIND_NAMES is out of step with TokenKind"); 
+
+static constexpr std::string_view token_kind_name(TokenKind kind)
+{
+    return TOKEN_KIND_NAMES[static_cast<size_t>(kind)].name; 
+}
+
+struct Keyword
+{
+    std::string_view spelling; 
+    TokenKind kind; 
+};
+
+// reserved words; the lexer's keyword hash table is generated from this list
+static constexpr Keyword KEYWORDS[] =
+{
+    { "int",      TokenKind::Int      },
+    { "if",       TokenKind::If       },
+    { "else",     TokenKind::Else     },
+    { "do",       TokenKind::Do       },
+    { "for",      TokenKind::For      },
+    { "while",    TokenKind::While    },
+    { "break",    TokenKind::Break    },
+    { "continue", TokenKind::Continue },
+    { "return",   TokenKind::Return   }
+};
 
-static bool is_keyword(TokenKind kind)
+static constexpr bool is_keyword(TokenKind kind)
 {
-    switch (kind)
-    {
-        case TokenKind::Int:
-        case TokenKind::If:
-        case TokenKind::Else:
-        case TokenKind::Do:
-        case TokenKind::For:
-        case TokenKind::While:
-        case TokenKind::Break:
-        case TokenKind::Continue:
-        case TokenKind::Return:
-            return true;
-    }
+    for (auto& keyword : KEYWORDS)
+        if (keyword.kind == kind) return true;
     return false;
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "token.hpp"
+
+// Tokens of a whole file stored as parallel arrays of kinds, source offsets
+// and payloads. The payload is the decoded value of integer constants and
+// the value length of everything else, which is sliced back out of the
+// source buffer on access.
+class TokenList
+{
+    public:
+        TokenList() = default; 
+        TokenList(std::string_view source) : m_Source(source)
+        {
+        }
+
+        size_t size() const { return m_Kinds.size(); }
+        bool empty() const { return m_Kinds.empty(); }
+
+        void reserve(size_t count)
+        {
+            m_Kinds.reserve(count); 
+            m_Offsets.reserve(count); 
+            m_Payloads.reserve(count); 
+        }
+
+        void push_back(const Token& token)
+        {
+            m_Kinds.emplace_back(token.kind); 
+            m_Offsets.emplace_back(token.offset); 
+            m_Payloads.emplace_back(is_constant(token.kind) ? token.constant : static_cast<uint32_t>(token.value.length())); 
+        }
+
+        void append(const TokenList& other)
+        {
+            m_Kinds.insert(m_Kinds.end(), other.m_Kinds.begin(), other.m_Kinds.end()); 
+            m_Offsets.insert(m_Offsets.end(), other.m_Offsets.begin(), other.m_Offsets.end()); 
+            m_Payloads.insert(m_Payloads.end(), other.m_Payloads.begin(), other.m_Payloads.end()); 
+        }
+
+        std::string_view source() const { return m_Source; }
+        TokenKind kind(size_t i) const { return m_Kinds[i]; }
+        uint32_t offset(size_t i) const { return m_Offsets[i]; }
+
+        Token operator[](size_t i) const
+        {
+            if (is_constant(m_Kinds[i]))
+                return Token(m_Kinds[i], m_Offsets[i], m_Payloads[i]); 
+            return Token(m_Kinds[i], m_Offsets[i], m_Source.substr(m_Offsets[i], m_Payloads[i])); 
+        }
+
+    private:
+        std::string_view m_Source; 
+        std::vector<TokenKind> m_Kinds; 
+        std::vector<uint32_t> m_Offsets, m_Payloads; 
+
+        static bool is_constant(TokenKind kind)
+        {
+            return kind == TokenKind::IntConstant || kind == TokenKind::HexConstant; 
+        }
+};
@@ -0,0 +1,50 @@
+#include "token_stream.hpp"
+
+#include "lexer.hpp"
+
+void TokenStream::Fill(size_t count)
+{
+    while (m_Count < count)
+    {
+        auto& slot = m_Ring[(m_Head + m_Count) % CAPACITY]; 
+        bool fresh = Lex(slot); 
+        // identifiers are interned here rather than in LexToken, which runs
+        // on several threads at once for large files
+        if (slot.kind == TokenKind::Identifier)
+            slot.id = m_Lexer.Intern(slot.value); 
+        if (fresh && LOG_ENABLED(Lexer, Info))
+            LogToken(slot); 
+        m_Count++; 
+    }
+}
+
+bool TokenStream::Lex(Token& slot)
+{
+    // once the input is exhausted keep handing out the end-of-input token
+    if (m_Count > 0 && m_Ring[(m_Head + m_Count - 1) % CAPACITY].kind == TokenKind::None)
+    {
+        slot = m_Ring[(m_Head + m_Count - 1) % CAPACITY]; 
+        return false; 
+    }
+    if (m_List)
+    {
+        slot = m_Index < m_List->size() ? (*m_List)[m_Index++] : 
+            Token(TokenKind::None, static_cast<uint32_t>(m_List->source().length())); 
+        return true; 
+    }
+    // None before the end of input is a character the lexer skipped
+    do slot = m_Lexer.LexToken(m_Str); 
+    while (slot.kind == TokenKind::None && m_Str.hasCapacity()); 
+    return true; 
+}
+
+void TokenStream::LogToken(const Token& token)
+{
+    // line:column, kind and, for identifiers and constants, the spelling
+    auto location = m_Lexer.Locate(token.offset); 
+    auto& out = Log::Stream(LogLevel::Info); 
+    out << location.line << ":" << location.column << " " << token_kind_name(token.kind); 
+    if (!token.value.empty() && token.value != token_kind_name(token.kind))
+        out << " " << token.value; 
+    out << "\n"; 
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "stack_str.hpp"
+#include "token.hpp"
+#include "token_list.hpp"
+
+class Lexer; 
+
+// Pull-based token source. Tokens are lexed on demand into a small ring
+// buffer, so memory does not grow with the size of the input, or copied
+// from a list the lexer already produced. References returned by Peek/Next
+// stay valid until CAPACITY - LOOKAHEAD further tokens have been consumed.
+class TokenStream
+{
+    public:
+        static constexpr size_t CAPACITY = 8; 
+        static constexpr size_t LOOKAHEAD = 2; 
+
+        TokenStream(Lexer& lexer, std::string_view source) : m_Lexer(lexer), m_Str(source)
+        {
+        }
+        // tokens must outlive the stream
+        TokenStream(Lexer& lexer, const TokenList& tokens) : m_Lexer(lexer), m_Str(std::string_view()), m_List(&tokens)
+        {
+        }
+
+        const Token& Peek(size_t offset = 0)
+        {
+            if (offset >= m_Count) Fill(offset + 1); 
+            return m_Ring[(m_Head + offset) % CAPACITY]; 
+        }
+
+        const Token& Next()
+        {
+            if (m_Count == 0) Fill(1); 
+            const Token& token = m_Ring[m_Head]; 
+            // the end-of-input token is sticky
+            if (token.kind != TokenKind::None)
+            {
+                m_Head = (m_Head + 1) % CAPACITY; 
+                m_Count--; 
+            }
+            return token; 
+        }
+
+        void Consume() { Next(); }
+
+    private:
+        Lexer& m_Lexer; 
+        StackString m_Str; 
+        const TokenList* m_List = nullptr; 
+        size_t m_Index = 0; 
+        std::array<Token, CAPACITY> m_Ring{}; 
+        size_t m_Head = 0, m_Count = 0; 
+
+        static_assert(LOOKAHEAD < CAPACITY, "lookahead must leave room for consumed tokens"); 
+
+        // lex until at least count tokens are buffered
+        void Fill(size_t count); 
+        // produce the token after the last buffered one into slot, false if
+        // it only repeats the end-of-input token
+        bool Lex(Token& slot); 
+        // print a token for -emit=tokens
+        void LogToken(const Token& token); 
+};
@@ -1,57 +0,0 @@
-#pragma once
-
-static inline bool is_digit(char c)
-{
-    switch (c)
-    {
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            return true; 
-    }
-
-    return false; 
-}
-
-static inline bool is_nondigit(char c)
-{
-    return isalpha(c) || c == '_'; 
-}
-
-static inline bool is_hexdigit(char c)
-{
-    switch (c)
-    {
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-        case 'a':
-        case 'A':
-        case 'b':
-        case 'B':
-        case 'c':
-        case 'C':
-        case 'd':
-        case 'D':
-        case 'e':
-        case 'E':
-        case 'f':
-        case 'F':
-            return true;
-    }
-    return false;
-}
\ No newline at end of file
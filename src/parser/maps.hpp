@@ -1,9 +1,63 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+
 #include "lexer/token_kind.hpp"
 #include "syntax/includes.hpp"
 
-static std::unordered_map<TokenKind, UnaryOpType> TOKEN_TO_UNARY_TYPE
+// Operator tokens of the expression parser. Each list is flattened at compile
+// time into an array indexed by token kind, so classifying the next token is
+// a single load.
+
+template <typename Type>
+struct TokenMapping
+{
+    TokenKind kind; 
+    Type type; 
+};
+
+// operator a token kind stands for; found is false for any other token
+template <typename Type>
+struct TokenOperator
+{
+    Type type; 
+    bool found; 
+};
+
+template <typename Type, size_t N>
+static constexpr std::array<TokenOperator<Type>, TOKEN_KIND_COUNT> index_by_token_kind(const TokenMapping<Type> (&mappings)[N])
+{
+    std::array<TokenOperator<Type>, TOKEN_KIND_COUNT> table{}; 
+    for (auto& mapping : mappings)
+        table[static_cast<size_t>(mapping.kind)] = { mapping.type, true }; 
+    return table; 
+}
+
+template <typename Type, size_t N>
+static constexpr bool maps_each_token_once(const TokenMapping<Type> (&mappings)[N])
+{
+    for (size_t i = 0; i < N; i++)
+        for (size_t j = i + 1; j < N; j++)
+            if (mappings[i].kind == mappings[j].kind) return false; 
+    return true; 
+}
+
+// whether every enumerator below type_count has a token
+template <typename Type, size_t N>
+static constexpr bool maps_every_type(const TokenMapping<Type> (&mappings)[N], size_t type_count)
+{
+    for (size_t type = 0; type < type_count; type++)
+    {
+        bool found = false; 
+        for (auto& mapping : mappings)
+            found = found || static_cast<size_t>(mapping.type) == type; 
+        if (!found) return false; 
+    }
+    return true; 
+}
+
+static constexpr TokenMapping<UnaryOpType> UNARY_OPERATOR_TOKENS[] =
 {
     { TokenKind::Minus,       UnaryOpType::Negation        },
     { TokenKind::Tilde,       UnaryOpType::Complement      },
@@ -11,8 +65,12 @@ static std::unordered_map<TokenKind, UnaryOpType> TOKEN_TO_UNARY_TYPE
     { TokenKind::PlusPlus,    UnaryOpType::PrefixIncrement },
     { TokenKind::MinusMinus,  UnaryOpType::PrefixDecrement }
 };
+// the postfix forms are recognized after an operand, not through this table
+static_assert(maps_each_token_once(UNARY_OPERATOR_TOKENS), "token listed twice in UNARY_OPERATOR_TOKENS"); 
+
+static constexpr auto TOKEN_TO_UNARY_TYPE = index_by_token_kind(UNARY_OPERATOR_TOKENS); 
 
-static std::unordered_map<TokenKind, BinaryOpType> TOKEN_TO_BINARY_TYPE
+static constexpr TokenMapping<BinaryOpType> BINARY_OPERATOR_TOKENS[] =
 {
     { TokenKind::Plus,               BinaryOpType::Addition           },
     { TokenKind::Minus,              BinaryOpType::Subtraction        },
@@ -33,8 +91,60 @@ static std::unordered_map<TokenKind, BinaryOpType> TOKEN_TO_BINARY_TYPE
     { TokenKind::LeftShift,          BinaryOpType::BitwiseLeftShift   },
     { TokenKind::RightShift,         BinaryOpType::BitwiseRightShift  }
 };
+// Comma is last and parsed on its own
+static_assert(maps_each_token_once(BINARY_OPERATOR_TOKENS), "token listed twice in BINARY_OPERATOR_TOKENS"); 
+static_assert(maps_every_type(BINARY_OPERATOR_TOKENS, static_cast<size_t>(BinaryOpType::Comma)), "BinaryOpType without a token"); 
+
+// binding power of a binary operator, higher binds tighter; operators of
+// the same power associate to the left
+static constexpr uint8_t BinaryPrecedence(BinaryOpType type)
+{
+    switch (type)
+    {
+        case BinaryOpType::LogicalOr:          return 1;
+        case BinaryOpType::LogicalAnd:         return 2;
+        case BinaryOpType::BitwiseOr:          return 3;
+        case BinaryOpType::BitwiseXOR:         return 4;
+        case BinaryOpType::BitwiseAnd:         return 5;
+        case BinaryOpType::Equal:
+        case BinaryOpType::NotEqual:           return 6;
+        case BinaryOpType::LessThan:
+        case BinaryOpType::LessThanOrEqual:
+        case BinaryOpType::GreaterThan:
+        case BinaryOpType::GreaterThanOrEqual: return 7;
+        case BinaryOpType::BitwiseLeftShift:
+        case BinaryOpType::BitwiseRightShift:  return 8;
+        case BinaryOpType::Addition:
+        case BinaryOpType::Subtraction:        return 9;
+        case BinaryOpType::Multiplication:
+        case BinaryOpType::Division:
+        case BinaryOpType::Remainder:          return 10;
+        // the comma operator is parsed on its own, below assignments
+        case BinaryOpType::Comma:              return 0;
+    }
+    return 0; 
+}
+
+struct BinaryOperator
+{
+    BinaryOpType type; 
+    // 0 for tokens that are not binary operators
+    uint8_t precedence; 
+};
+
+// precedence doubles as the found flag, so the binary operator table keeps
+// its own entry type
+static constexpr std::array<BinaryOperator, TOKEN_KIND_COUNT> build_binary_operators()
+{
+    std::array<BinaryOperator, TOKEN_KIND_COUNT> table{}; 
+    for (auto& mapping : BINARY_OPERATOR_TOKENS)
+        table[static_cast<size_t>(mapping.kind)] = { mapping.type, BinaryPrecedence(mapping.type) }; 
+    return table; 
+}
 
-static std::unordered_map<TokenKind, AssignmentOpType> TOKEN_TO_ASSIGNMENT_OP_TYPE
+static constexpr std::array<BinaryOperator, TOKEN_KIND_COUNT> TOKEN_TO_BINARY_OPERATOR = build_binary_operators(); 
+
+static constexpr TokenMapping<AssignmentOpType> ASSIGNMENT_OPERATOR_TOKENS[] =
 {
     { TokenKind::AddEquals,        AssignmentOpType::Add            },
     { TokenKind::MinusEquals,      AssignmentOpType::Minus          },
@@ -46,4 +156,8 @@ static std::unordered_map<TokenKind, AssignmentOpType> TOKEN_TO_ASSIGNMENT_OP_TY
     { TokenKind::OrEquals,         AssignmentOpType::LogicalOr      },
     { TokenKind::AndEquals,        AssignmentOpType::LogicalAnd     },
     { TokenKind::CaretEquals,      AssignmentOpType::LogicalXOR     }
-};
\ No newline at end of file
+};
+static_assert(maps_each_token_once(ASSIGNMENT_OPERATOR_TOKENS), "token listed twice in ASSIGNMENT_OPERATOR_TOKENS"); 
+static_assert(maps_every_type(ASSIGNMENT_OPERATOR_TOKENS, static_cast<size_t>(AssignmentOpType::LogicalXOR) + 1), "AssignmentOpType without a token"); 
+
+static constexpr auto TOKEN_TO_ASSIGNMENT_OP_TYPE = index_by_token_kind(ASSIGNMENT_OPERATOR_TOKENS); 
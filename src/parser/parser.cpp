@@ -1,45 +1,40 @@
 #include "parser.hpp"
 
-const Token Parser::PeekToken()
+const Token& Parser::PeekToken(size_t offset)
 {
-    if (m_Position >= m_Tokens.size())
-        return Token(TokenKind::None, 0, 0); 
-    return m_Tokens[m_Position];
+    assert(offset < TokenStream::LOOKAHEAD);
+    return m_Tokens->Peek(offset);
 }
 
-const Token Parser::NextToken()
+const Token& Parser::NextToken()
 {
-    if (m_Position >= m_Tokens.size())
-        return Token(TokenKind::None, 0, 0); 
-    const auto& token = m_Tokens[m_Position];
-    m_Position++;
-    return token; 
-}
-
-void Parser::RevertToken()
-{
-    if (m_Position <= 0) return;
-    m_Position--;
+    return m_Tokens->Next();
 }
 
 void Parser::ConsumeToken()
 {
-    if (m_Position >= m_Tokens.size()) return; 
-    m_Position++; 
+    m_Tokens->Consume();
 }
 
 void Parser::ExceptParse(const std::string& msg, const Token& current_token) const
 {
-    std::string prefix = std::to_string(current_token.line) + ":" + std::to_string(current_token.position) + ": ";
-    std::string unexpected = prefix + "Unexpected token: " + TOKEN_KIND_NAMES[current_token.kind];
+    auto location = m_Lexer->Locate(current_token.offset); 
+    std::string prefix = std::to_string(location.line) + ":" + std::to_string(location.column) + ": ";
+    std::string unexpected = prefix + "Unexpected token: " + std::string(token_kind_name(current_token.kind));
     throw std::runtime_error(unexpected + "\n" + prefix + msg);
 }
 
+void Parser::EnterNesting(const Token& token)
+{
+    if (++m_Depth > m_MaxDepth) 
+        ExceptParse("error: Nesting exceeds the maximum depth of " + std::to_string(m_MaxDepth), token); 
+}
+
 void Parser::keyword(TokenKind kind)
 {
     assert(is_keyword(kind));
-    auto token = NextToken();
-    if (token.kind != kind) ExceptParse("error: Expected keyword '" + TOKEN_KIND_NAMES[kind] + "'", token);
+    const auto& token = NextToken();
+    if (token.kind != kind) ExceptParse("error: Expected keyword '" + std::string(token_kind_name(kind)) + "'", token);
 }
 
 void Parser::colon()
@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <exception>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <vector>
 
@@ -13,25 +14,51 @@
 class Parser
 {
 public:
+    // deepest nesting of statements and expressions accepted by default
+    static constexpr size_t DEFAULT_MAX_DEPTH = 1 << 18; 
+
     Parser(std::unique_ptr<Lexer> lexer) : m_Lexer(std::move(lexer))
     {
     }
         
     virtual ~Parser() = default; 
 
+    // the returned tree is owned by the parser and freed with it
     virtual AbstractSyntax::Ref ParseFile(const std::string& filepath) = 0; 
     virtual void LogTree(std::ostream& out, const AbstractSyntax::Ref root) const = 0; 
 
+    void SetMaxDepth(size_t max_depth) { m_MaxDepth = max_depth; }
+    // spellings of the identifiers in the parsed trees
+    StringInterner& Interner() { return m_Lexer->Interner(); }
+    // nodes that rewrite a parsed tree have to be allocated here as well
+    Arena& NodeArena() { return m_Arena; }
+
 protected:
     std::unique_ptr<Lexer> m_Lexer; 
-    std::vector<Token> m_Tokens; 
+    std::optional<TokenStream> m_Tokens; 
+    // every node of the tree is allocated here
+    Arena m_Arena; 
+
+    template<typename T, typename ... Args>
+    T* CreateNode(Args&& ... args)
+    {
+        return m_Arena.Create<T>(std::forward<Args>(args)...); 
+    }
+
+    // statements and expressions currently open, bounded by m_MaxDepth so
+    // that pathological input fails with an error instead of exhausting memory
+    size_t m_Depth = 0; 
+    size_t m_MaxDepth = DEFAULT_MAX_DEPTH; 
 
-    const Token PeekToken();
-    const Token NextToken();
-    void RevertToken();
+    void EnterNesting(const Token& token); 
+    void LeaveNesting() { m_Depth--; }
+
+    // offset must be below TokenStream::LOOKAHEAD
+    const Token& PeekToken(size_t offset = 0);
+    const Token& NextToken();
     void ConsumeToken();
 
-    void ExceptParse(const std::string& msg, const Token& current_token) const;
+    [[noreturn]] void ExceptParse(const std::string& msg, const Token& current_token) const;
 
     void keyword(TokenKind kind);
     void colon();
@@ -46,7 +73,4 @@ protected:
     void lparen(const Token& token) const;
     void rparen();
     void rparen(const Token& token) const;
-
-private:
-    size_t m_Position = 0; 
 };
\ No newline at end of file
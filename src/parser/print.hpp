@@ -1,18 +1,120 @@
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <ostream>
+#include <vector>
 
 #include "syntax/includes.hpp"
 
 class ASTPrinter
 {
     public:
-        ASTPrinter(std::ostream& outputstream) : m_OutputStream(outputstream)
+        ASTPrinter(std::ostream& outputstream, const StringInterner& names) : m_OutputStream(outputstream), m_Names(names)
         {
         }
 
-        void PrintSyntax(AbstractSyntax::Ref syntax)
+        void PrintSyntax(AbstractSyntax::Ref root)
+        {
+            // children are printed off an explicit stack so that deeply
+            // nested trees cannot overflow the native one; each node writes
+            // what precedes its first child right away and queues the rest
+            m_Items.emplace_back(root); 
+            while (!m_Items.empty())
+            {
+                auto item = m_Items.back(); 
+                m_Items.pop_back(); 
+                switch (item.action)
+                {
+                    case PrintAction::Syntax:
+                        VisitSyntax(item.syntax); 
+                        break; 
+                    case PrintAction::Text:
+                        m_OutputStream << item.text; 
+                        break; 
+                    case PrintAction::Spaces:
+                        m_OutputStream << m_Spaces; 
+                        break; 
+                    case PrintAction::BodyIndent:
+                        m_OutputStream << std::string(m_IndentSize, ' '); 
+                        break; 
+                    case PrintAction::Dedent:
+                        SetIndent(m_Indent - 1); 
+                        break; 
+                }
+            }
+        }
+
+    private:
+        enum class PrintAction : uint8_t
+        {
+            Syntax,
+            Text,
+            // the current indentation
+            Spaces,
+            // the extra level of a body that is not a block
+            BodyIndent,
+            Dedent
+        };
+
+        // a node to print, literal text or a deferred indentation change
+        struct PrintItem
+        {
+            PrintAction action; 
+            AbstractSyntax::Ref syntax = nullptr; 
+            std::string_view text; 
+
+            PrintItem(AbstractSyntax::Ref syntax) : action(PrintAction::Syntax), syntax(syntax)
+            {
+            }
+
+            PrintItem(std::string_view text) : action(PrintAction::Text), text(text)
+            {
+            }
+
+            PrintItem(const char* text) : action(PrintAction::Text), text(text)
+            {
+            }
+
+            PrintItem(PrintAction action) : action(action)
+            {
+            }
+        };
+
+        std::ostream& m_OutputStream;
+        const StringInterner& m_Names; 
+        std::vector<PrintItem> m_Items; 
+
+        void Schedule(std::initializer_list<PrintItem> items)
+        {
+            // the stack runs last in, first out
+            m_Items.insert(m_Items.end(), std::rbegin(items), std::rend(items)); 
+        }
+
+        void Schedule(const std::vector<PrintItem>& items)
+        {
+            m_Items.insert(m_Items.end(), items.rbegin(), items.rend()); 
+        }
+
+        // bodies that are not blocks are pushed in by one extra level
+        void AddBody(std::vector<PrintItem>& items, Statement::Ref body)
+        {
+            if (body->type() != SyntaxType::CompoundBlock)
+                items.emplace_back(PrintAction::BodyIndent); 
+            items.emplace_back(body); 
+        }
+
+        void AddBlockItem(std::vector<PrintItem>& items, Statement::Ref statement)
+        {
+            AddBody(items, statement); 
+            if (statement->type() != SyntaxType::CompoundBlock)
+                items.insert(items.end() - 1, PrintAction::Spaces); 
+        }
+
+        void VisitSyntax(AbstractSyntax::Ref syntax)
         {
             switch (syntax->type())
             {
@@ -79,33 +181,28 @@ class ASTPrinter
             }
         }
 
-    private:
-        std::ostream& m_OutputStream;
-
         void PrintProgram(Program::Ref program)
         {
             m_OutputStream << "Program(" << std::endl;
             SetIndent(m_Indent + 1); 
-            PrintFunction(program->function);
-            SetIndent(m_Indent - 1);
-            m_OutputStream << ")" << std::endl;
+            Schedule({ program->function, PrintAction::Dedent, ")\n" });
         }
 
         void PrintFunction(Function::Ref function)
         {
-            m_OutputStream << m_Spaces << function->name << "(" << std::endl;
+            m_OutputStream << m_Spaces << m_Names.Lookup(function->name) << "(" << std::endl;
             SetIndent(m_Indent + 1); 
-            for (auto statement : function->Statements())
-                PrintSyntax(statement);
-            SetIndent(m_Indent - 1); 
-            m_OutputStream << m_Spaces << ")" << std::endl;
+            std::vector<PrintItem> items(function->Statements().begin(), function->Statements().end()); 
+            items.emplace_back(PrintAction::Dedent); 
+            items.emplace_back(PrintAction::Spaces); 
+            items.emplace_back(")\n"); 
+            Schedule(items); 
         }
 
         void PrintStatementExpression(StatementExpression::Ref statement_expression)
         {
             m_OutputStream << m_Spaces;
-            PrintSyntax(statement_expression->expression);
-            m_OutputStream << ";\n";
+            Schedule({ statement_expression->expression, ";\n" });
         }
 
         void PrintDoWhileStatement(DoWhileStatement::Ref do_while_statement)
@@ -114,53 +211,43 @@ class ASTPrinter
             m_OutputStream << "do\n";
             if (do_while_statement->body->type() != SyntaxType::CompoundBlock)
                 m_OutputStream << std::string(m_IndentSize, ' ');
-            PrintSyntax(do_while_statement->body);
-            m_OutputStream << m_Spaces << "while (";
-            PrintSyntax(do_while_statement->condition);
-            m_OutputStream << ");\n";
+            Schedule({ do_while_statement->body, PrintAction::Spaces, "while (", do_while_statement->condition, ");\n" });
         }
 
         void PrintWhileStatement(WhileStatement::Ref while_statement)
         {
             m_OutputStream << m_Spaces;
             m_OutputStream << "while (";
-            PrintSyntax(while_statement->condition);
-            m_OutputStream << ")\n";
-            if (while_statement->body->type() != SyntaxType::CompoundBlock)
-                m_OutputStream << std::string(m_IndentSize, ' ');
-            PrintSyntax(while_statement->body);
+            std::vector<PrintItem> items{ while_statement->condition, ")\n" }; 
+            AddBody(items, while_statement->body); 
+            Schedule(items); 
         }
 
         void PrintForDeclStatement(ForDeclStatement::Ref for_decl_statement)
         {
             m_OutputStream << m_Spaces << "for (";
+            std::vector<PrintItem> items{ " ", for_decl_statement->condition, "; ", 
+                for_decl_statement->post_expression, ")\n" }; 
+            AddBody(items, for_decl_statement->body); 
+            Schedule(items); 
+            // the declaration comes first, so it goes on top
             PrintDeclaration(for_decl_statement->declaration, false); 
-            m_OutputStream << " "; 
-            PrintSyntax(for_decl_statement->condition);
-            m_OutputStream << "; ";
-            PrintSyntax(for_decl_statement->post_expression);
-            m_OutputStream << ")\n";
-            if (for_decl_statement->body->type() != SyntaxType::CompoundBlock)
-                m_OutputStream << std::string(m_IndentSize, ' ');
-            PrintSyntax(for_decl_statement->body);
         }
 
         void PrintForStatement(ForStatement::Ref for_statement)
         {
             m_OutputStream << m_Spaces << "for (";
-            PrintSyntax(for_statement->expression); 
-            m_OutputStream << ";"; 
+            std::vector<PrintItem> items{ for_statement->expression, ";" }; 
             if (for_statement->condition->type() != SyntaxType::Null) 
-                m_OutputStream << " ";
-            PrintSyntax(for_statement->condition);
-            m_OutputStream << ";";
+                items.emplace_back(" ");
+            items.emplace_back(for_statement->condition);
+            items.emplace_back(";");
             if (for_statement->post_expression->type() != SyntaxType::Null) 
-                m_OutputStream << " ";
-            PrintSyntax(for_statement->post_expression);
-            m_OutputStream << ")\n";
-            if (for_statement->body->type() != SyntaxType::CompoundBlock)
-                m_OutputStream << std::string(m_IndentSize, ' ');
-            PrintSyntax(for_statement->body);
+                items.emplace_back(" ");
+            items.emplace_back(for_statement->post_expression);
+            items.emplace_back(")\n");
+            AddBody(items, for_statement->body); 
+            Schedule(items); 
         }
 
         void PrintBreakStatement(BreakStatement::Ref break_statement)
@@ -175,7 +262,7 @@ class ASTPrinter
 
         void PrintAssignmentOp(AssignmentOp::Ref op)
         {
-            m_OutputStream << op->lvalue << " "; 
+            m_OutputStream << m_Names.Lookup(op->lvalue) << " "; 
             switch (op->OpType())
             {
                 case AssignmentOpType::Add:            m_OutputStream << "+="; break; 
@@ -190,7 +277,7 @@ class ASTPrinter
                 case AssignmentOpType::LogicalXOR:     m_OutputStream << "^="; break; 
             }
             m_OutputStream << " ";
-            PrintSyntax(op->rvalue);
+            m_Items.emplace_back(op->rvalue);
         }
 
         void PrintDeclaration(Declaration::Ref decl, bool use_space = true)
@@ -198,19 +285,21 @@ class ASTPrinter
             size_t num_vars = decl->variables.size(); 
             if (use_space) m_OutputStream << m_Spaces << "int "; 
             else m_OutputStream << "int ";
+            std::vector<PrintItem> items; 
             for (size_t i = 0; i < num_vars; i++)
             {
-                auto var = decl->variables[i]; 
-                m_OutputStream << var.name; 
+                const auto& var = decl->variables[i]; 
+                items.emplace_back(m_Names.Lookup(var.name)); 
                 if (var.expression)
                 {
-                    m_OutputStream << " = ";
-                    PrintSyntax(var.expression);
+                    items.emplace_back(" = ");
+                    items.emplace_back(var.expression);
                 }
-                if (i != num_vars - 1) m_OutputStream << ", ";
+                if (i != num_vars - 1) items.emplace_back(", ");
             }
-            m_OutputStream << ";"; 
-            if (use_space) m_OutputStream << "\n";
+            items.emplace_back(";"); 
+            if (use_space) items.emplace_back("\n");
+            Schedule(items); 
         }
 
         void PrintCompoundBlock(CompoundBlock::Ref compoundBlock)
@@ -219,52 +308,40 @@ class ASTPrinter
             SetIndent(m_Indent + 1); 
             if (compoundBlock->statements.empty()) 
                 m_OutputStream << "\n";
-            for (auto statement : compoundBlock->statements)
-                PrintSyntax(statement); 
-            SetIndent(m_Indent - 1); 
-            m_OutputStream << m_Spaces << "}\n";
-        }
-
-        void PrintBlockItem(Statement::Ref statement)
-        {
-            if (statement->type() != SyntaxType::CompoundBlock)
-                std::cout << m_Spaces;
-            PrintSyntax(statement); 
+            std::vector<PrintItem> items(compoundBlock->statements.begin(), compoundBlock->statements.end()); 
+            items.emplace_back(PrintAction::Dedent); 
+            items.emplace_back(PrintAction::Spaces); 
+            items.emplace_back("}\n"); 
+            Schedule(items); 
         }
 
         void PrintIfStatement(IfStatement::Ref if_statement)
         {
             m_OutputStream << m_Spaces << "IF (";
-            PrintSyntax(if_statement->if_conditional.condition); 
-            m_OutputStream << ")\n";
-            if (if_statement->if_conditional.statement->type() != SyntaxType::CompoundBlock)
-                m_OutputStream << std::string(m_IndentSize, ' ');
-            PrintBlockItem(if_statement->if_conditional.statement);
-            for (auto else_if : if_statement->else_ifs)
+            std::vector<PrintItem> items{ if_statement->if_conditional.condition, ")\n" }; 
+            AddBlockItem(items, if_statement->if_conditional.statement);
+            for (const auto& else_if : if_statement->else_ifs)
             {
-                m_OutputStream << m_Spaces << "ELSE IF (";
-                PrintSyntax(else_if.condition); 
-                m_OutputStream << ")\n"; 
-                if (else_if.statement->type() != SyntaxType::CompoundBlock)
-                    m_OutputStream << std::string(m_IndentSize, ' ');
-                PrintBlockItem(else_if.statement); 
+                items.emplace_back(PrintAction::Spaces); 
+                items.emplace_back("ELSE IF (");
+                items.emplace_back(else_if.condition); 
+                items.emplace_back(")\n"); 
+                AddBlockItem(items, else_if.statement); 
             }
             if (if_statement->else_statement != nullptr)
             {
-                m_OutputStream << m_Spaces << "ELSE\n";
-                if (if_statement->else_statement->type() != SyntaxType::CompoundBlock)
-                    m_OutputStream << std::string(m_IndentSize, ' ');
-                PrintBlockItem(if_statement->else_statement); 
+                items.emplace_back(PrintAction::Spaces); 
+                items.emplace_back("ELSE\n");
+                AddBlockItem(items, if_statement->else_statement); 
             }
+            Schedule(items); 
         }
 
         void PrintReturn(ReturnStatement::Ref return_statement)
         {
             m_OutputStream << m_Spaces << "return ";
             SetIndent(m_Indent + 1);  
-            PrintSyntax(return_statement->expression);
-            SetIndent(m_Indent - 1); 
-            m_OutputStream << ";\n";
+            Schedule({ return_statement->expression, PrintAction::Dedent, ";\n" });
         }
 
         void PrintIntConstant(IntConstant::Ref constant)
@@ -282,65 +359,57 @@ class ASTPrinter
                 case UnaryOpType::PrefixDecrement:  m_OutputStream << "--"; break;
                 case UnaryOpType::PrefixIncrement:  m_OutputStream << "++"; break;
                 case UnaryOpType::PostfixDecrement:
-                    PrintSyntax(op->expr);
-                    m_OutputStream << "--";
+                    Schedule({ op->expr, "--" });
                     return;
                 case UnaryOpType::PostfixIncrement:
-                    PrintSyntax(op->expr);
-                    m_OutputStream << "++";
+                    Schedule({ op->expr, "++" });
                     return;
             }
-            PrintSyntax(op->expr);
+            m_Items.emplace_back(op->expr);
         }
 
         void PrintBinaryOp(BinaryOp::Ref op)
         {
-            PrintSyntax(op->lvalue);
-            m_OutputStream << " ";
+            const char* symbol = ""; 
             switch (op->OpType())
             {
-                case BinaryOpType::Addition:           m_OutputStream << "+";  break;
-                case BinaryOpType::Subtraction:        m_OutputStream << "-";  break;
-                case BinaryOpType::Multiplication:     m_OutputStream << "*";  break;
-                case BinaryOpType::Division:           m_OutputStream << "/";  break;
-                case BinaryOpType::LogicalOr:          m_OutputStream << "||"; break;
-                case BinaryOpType::LogicalAnd:         m_OutputStream << "&&"; break;
-                case BinaryOpType::Equal:              m_OutputStream << "=="; break;
-                case BinaryOpType::NotEqual:           m_OutputStream << "!="; break;
-                case BinaryOpType::LessThan:           m_OutputStream << "<";  break;
-                case BinaryOpType::LessThanOrEqual:    m_OutputStream << "<="; break;
-                case BinaryOpType::GreaterThan:        m_OutputStream << ">";  break;
-                case BinaryOpType::GreaterThanOrEqual: m_OutputStream << ">="; break;
-                case BinaryOpType::Remainder:          m_OutputStream << "%";  break; 
-                case BinaryOpType::BitwiseOr:          m_OutputStream << "|";  break;
-                case BinaryOpType::BitwiseAnd:         m_OutputStream << "&";  break;
-                case BinaryOpType::BitwiseXOR:         m_OutputStream << "^";  break;
-                case BinaryOpType::BitwiseLeftShift:   m_OutputStream << "<<"; break;
-                case BinaryOpType::BitwiseRightShift:  m_OutputStream << ">>"; break; 
-                case BinaryOpType::Comma:              m_OutputStream << ",";  break;
+                case BinaryOpType::Addition:           symbol = " + ";  break;
+                case BinaryOpType::Subtraction:        symbol = " - ";  break;
+                case BinaryOpType::Multiplication:     symbol = " * ";  break;
+                case BinaryOpType::Division:           symbol = " / ";  break;
+                case BinaryOpType::LogicalOr:          symbol = " || "; break;
+                case BinaryOpType::LogicalAnd:         symbol = " && "; break;
+                case BinaryOpType::Equal:              symbol = " == "; break;
+                case BinaryOpType::NotEqual:           symbol = " != "; break;
+                case BinaryOpType::LessThan:           symbol = " < ";  break;
+                case BinaryOpType::LessThanOrEqual:    symbol = " <= "; break;
+                case BinaryOpType::GreaterThan:        symbol = " > ";  break;
+                case BinaryOpType::GreaterThanOrEqual: symbol = " >= "; break;
+                case BinaryOpType::Remainder:          symbol = " % ";  break; 
+                case BinaryOpType::BitwiseOr:          symbol = " | ";  break;
+                case BinaryOpType::BitwiseAnd:         symbol = " & ";  break;
+                case BinaryOpType::BitwiseXOR:         symbol = " ^ ";  break;
+                case BinaryOpType::BitwiseLeftShift:   symbol = " << "; break;
+                case BinaryOpType::BitwiseRightShift:  symbol = " >> "; break; 
+                case BinaryOpType::Comma:              symbol = " , ";  break;
             }
-            m_OutputStream << " ";
-            PrintSyntax(op->rvalue);
+            Schedule({ op->lvalue, symbol, op->rvalue });
         }
 
         void PrintTernaryOp(TernaryOp::Ref op)
         {
-            PrintSyntax(op->condition);
-            m_OutputStream << " ? ";
-            PrintSyntax(op->lvalue);
-            m_OutputStream << " : ";
-            PrintSyntax(op->rvalue);
+            Schedule({ op->condition, " ? ", op->lvalue, " : ", op->rvalue });
         }
 
         void PrintVariableRef(VariableRef::Ref ref)
         {
-            m_OutputStream << ref->name; 
+            m_OutputStream << m_Names.Lookup(ref->name); 
         }
 
         void PrintAssignment(Assignment::Ref assignment)
         {
-            m_OutputStream << assignment->lvalue << " = ";
-            PrintSyntax(assignment->rvalue);
+            m_OutputStream << m_Names.Lookup(assignment->lvalue) << " = ";
+            m_Items.emplace_back(assignment->rvalue);
         }
 
     private:
@@ -354,12 +423,3 @@ class ASTPrinter
             m_Spaces = std::string(m_Indent * m_IndentSize, ' '); 
         }
 };
-
-static void print_ast(std::ostream& out, const AbstractSyntax::Ref root)
-{
-    if (root != nullptr)
-    {
-        ASTPrinter printer(out); 
-        printer.PrintSyntax(root); 
-    } else out << "NULL" << std::endl; 
-}
\ No newline at end of file
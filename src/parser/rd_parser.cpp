@@ -2,53 +2,44 @@
 
 AbstractSyntax::Ref RDParser::ParseFile(const std::string& filepath)
 {
-    m_Tokens = m_Lexer->LexFile(filepath); 
-    /*std::cout << "<--- Lexical Analysis --." << std::endl;
-    for (auto& token : m_Tokens)
-        std::cout << TOKEN_KIND_NAMES[token.kind] << ": " << (!token.value.empty() ? token.value : "NULL") << std::endl;*/
+    m_Tokens.emplace(m_Lexer->StreamFile(filepath)); 
+    m_Depth = 0; 
     return ParseProgram(); 
 }
 
 void RDParser::LogTree(std::ostream& out, const AbstractSyntax::Ref root) const
 {
-    print_ast(out, root);
+    if (root == nullptr)
+    {
+        out << "NULL" << std::endl; 
+        return; 
+    }
+    ASTPrinter(out, m_Lexer->Interner()).PrintSyntax(root); 
 }
 
 Program::Ref RDParser::ParseProgram()
 {
-    return CreateRef<Program>(ParseFunction()); 
+    return CreateNode<Program>(ParseFunction()); 
 }
 
 Function::Ref RDParser::ParseFunction()
 {
-    auto token = NextToken();
-    if (token.kind != TokenKind::Int) ExceptParse("error: Invalid return type", token); 
-    token = NextToken(); 
-    if (token.kind != TokenKind::Identifier) ExceptParse("error: Excepted function identifier", token); 
-    std::string name = token.value; 
+    const auto& type = NextToken();
+    if (type.kind != TokenKind::Int) ExceptParse("error: Invalid return type", type); 
+    const auto& identifier = NextToken(); 
+    if (identifier.kind != TokenKind::Identifier) ExceptParse("error: Excepted function identifier", identifier); 
+    auto name = identifier.id; 
     lparen();
     rparen();
-    return CreateRef<Function>(name, ParseCompoundBlock());
-}
-
-// Statement | Declaration
-Statement::Ref RDParser::ParseBlockItem()
-{
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::Int)
-    {
-        ConsumeToken(); 
-        return ParseDeclaration(); 
-    } else return ParseStatement(); 
+    return CreateNode<Function>(name, ParseCompoundBlock());
 }
 
 Variable RDParser::ParseVariable()
 {
-    auto token = NextToken(); 
+    const auto& token = NextToken(); 
     if (token.kind != TokenKind::Identifier) ExceptParse("error: Expected identifier", token); 
-    auto name = token.value; 
-    token = PeekToken(); 
-    if (token.kind == TokenKind::Equal)
+    auto name = token.id; 
+    if (PeekToken().kind == TokenKind::Equal)
     {
         ConsumeToken();
         // the comma operator is applicable to declarations unless wrapped in parenthesis
@@ -60,448 +51,457 @@ Declaration::Ref RDParser::ParseDeclaration()
 {
     // TODO: introduce type system
     // for now only int (4-bytes) exists
-    auto decl = CreateRef<Declaration>(4); 
-    decl->variables.emplace_back(ParseVariable()); 
-    auto token = PeekToken(); 
-    while (token.kind == TokenKind::Comma)
+    std::vector<Variable> variables{ ParseVariable() }; 
+    while (PeekToken().kind == TokenKind::Comma)
     {
         ConsumeToken();
-        decl->variables.emplace_back(ParseVariable()); 
-        token = PeekToken(); 
+        variables.emplace_back(ParseVariable()); 
     }
     semicolon();
-    return decl;
+    return CreateNode<Declaration>(4, m_Arena.CreateArray(variables));
 }
 
 Statement::Ref RDParser::ParseStatement()
 {
-    auto token = PeekToken(); 
+    // statements nested in other statements are parsed off an explicit stack
+    // of frames instead of recursing, so deep nesting cannot overflow the
+    // native stack
+    std::vector<StatementFrame> frames; 
+    while (true)
+    {
+        auto statement = ParseStatementHead(frames); 
+        if (statement == nullptr) continue; 
+        // hand the finished statement outwards until a frame needs another one
+        while (statement != nullptr)
+        {
+            if (frames.empty()) return statement; 
+            statement = CompleteStatement(frames, statement); 
+        }
+    }
+}
+
+CompoundBlock::Ref RDParser::ParseCompoundBlock()
+{
+    lbrace(PeekToken()); 
+    return AbstractSyntax::RefCast<CompoundBlock>(ParseStatement()); 
+}
+
+Statement::Ref RDParser::ParseStatementHead(std::vector<StatementFrame>& frames)
+{
     Statement::Ref statement; 
-    switch (token.kind)
+    switch (PeekToken().kind)
     {
         case TokenKind::Return:    return ParseReturnStatement(); 
-        case TokenKind::LeftBrace: return ParseCompoundBlock(); 
-        case TokenKind::If:        return ParseIfStatement();
-        case TokenKind::While:     return ParseWhileStatement(); 
-        case TokenKind::For:       return ParseForStatement(); 
-        case TokenKind::Do:        return ParseDoWhileStatement();
         case TokenKind::Break:     return ParseBreakStatement();
         case TokenKind::Continue:  return ParseContinueStatement();
+        case TokenKind::LeftBrace: 
+            EnterNesting(NextToken()); 
+            frames.emplace_back(StatementFrame::Kind::Block); 
+            return ContinueBlock(frames); 
+        case TokenKind::If:
+        {
+            EnterNesting(NextToken()); 
+            auto condition = ParseCondition(); 
+            frames.emplace_back(StatementFrame::Kind::IfBranch).condition = condition; 
+            return nullptr; 
+        }
+        case TokenKind::While:
+        {
+            EnterNesting(NextToken()); 
+            auto condition = ParseCondition(); 
+            frames.emplace_back(StatementFrame::Kind::WhileBody).condition = condition; 
+            return nullptr; 
+        }
+        case TokenKind::Do:
+            EnterNesting(NextToken()); 
+            frames.emplace_back(StatementFrame::Kind::DoWhileBody); 
+            return nullptr; 
+        case TokenKind::For:
+            EnterNesting(NextToken()); 
+            ParseForHeader(frames.emplace_back(StatementFrame::Kind::ForBody)); 
+            return nullptr; 
         default:                   
-            statement = CreateRef<StatementExpression>(ParseNullExpression()); 
+            statement = CreateNode<StatementExpression>(ParseNullExpression()); 
             break;
     }
     semicolon();
     return statement; 
 }
 
-CompoundBlock::Ref RDParser::ParseCompoundBlock()
+Statement::Ref RDParser::CompleteStatement(std::vector<StatementFrame>& frames, Statement::Ref statement)
 {
-    lbrace();
-    auto block = CreateRef<CompoundBlock>(); 
-    auto token = PeekToken(); 
-    while (token.kind != TokenKind::RightBrace)
+    auto& frame = frames.back(); 
+    switch (frame.kind)
     {
-        if (token.kind == TokenKind::None) ExceptParse("error: expected '}'", token);
-        block->statements.emplace_back(ParseBlockItem());
-        token = PeekToken(); 
+        case StatementFrame::Kind::Block:
+            frame.statements.emplace_back(statement); 
+            return ContinueBlock(frames); 
+        case StatementFrame::Kind::IfBranch:
+            frame.conditional = Conditional(frame.condition, statement); 
+            return ContinueIf(frames); 
+        case StatementFrame::Kind::ElseIfBranch:
+            frame.else_ifs.emplace_back(frame.condition, statement); 
+            return ContinueIf(frames); 
+        case StatementFrame::Kind::ElseBranch:
+            return PopStatement(frames, CreateNode<IfStatement>(frame.conditional, m_Arena.CreateArray(frame.else_ifs), statement)); 
+        case StatementFrame::Kind::WhileBody:
+            return PopStatement(frames, CreateNode<WhileStatement>(frame.condition, statement)); 
+        case StatementFrame::Kind::DoWhileBody:
+        {
+            keyword(TokenKind::While);
+            auto condition = ParseCondition(); 
+            semicolon();
+            return PopStatement(frames, CreateNode<DoWhileStatement>(statement, condition)); 
+        }
+        case StatementFrame::Kind::ForBody:
+            return PopStatement(frames, CreateNode<ForStatement>(frame.expression, frame.condition, frame.post_expression, statement)); 
+        case StatementFrame::Kind::ForDeclBody:
+            return PopStatement(frames, CreateNode<ForDeclStatement>(frame.declaration, frame.condition, frame.post_expression, statement)); 
     }
-    ConsumeToken(); 
-    return block; 
-}
-
-Conditional RDParser::ParseIfCondition()
-{
-    lparen();
-    auto condition = ParseExpression(); 
-    rparen();
-    return Conditional(condition, ParseStatement()); 
+    return nullptr; 
 }
 
-IfStatement::Ref RDParser::ParseIfStatement()
+// { (Statement | Declaration)* }
+Statement::Ref RDParser::ContinueBlock(std::vector<StatementFrame>& frames)
 {
-    keyword(TokenKind::If);
-    auto statement = CreateRef<IfStatement>(ParseIfCondition()); 
-    auto token = PeekToken(); 
-    while (token.kind == TokenKind::Else)
+    auto& frame = frames.back(); 
+    while (true)
     {
-        ConsumeToken();
-        token = PeekToken();
-        if (token.kind == TokenKind::If)
+        switch (PeekToken().kind)
         {
-            ConsumeToken(); 
-            statement->else_ifs.emplace_back(ParseIfCondition()); 
-        } else {
-            statement->else_statement = ParseStatement();  
-            break;
+            case TokenKind::Int:
+                ConsumeToken(); 
+                frame.statements.emplace_back(ParseDeclaration()); 
+                break; 
+            case TokenKind::RightBrace:
+                ConsumeToken(); 
+                return PopStatement(frames, CreateNode<CompoundBlock>(m_Arena.CreateArray(frame.statements))); 
+            case TokenKind::None:
+                ExceptParse("error: expected '}'", PeekToken());
+            default:
+                return nullptr; 
         }
-        token = PeekToken(); 
     }
-    return statement; 
 }
 
-DoWhileStatement::Ref RDParser::ParseDoWhileStatement()
+Statement::Ref RDParser::ContinueIf(std::vector<StatementFrame>& frames)
 {
-    keyword(TokenKind::Do);
-    auto body = ParseStatement();
-    keyword(TokenKind::While);
-    lparen();
-    auto condition = ParseExpression();
-    rparen();
-    semicolon();
-    return CreateRef<DoWhileStatement>(body, condition); 
+    auto& frame = frames.back(); 
+    if (PeekToken().kind != TokenKind::Else)
+        return PopStatement(frames, CreateNode<IfStatement>(frame.conditional, m_Arena.CreateArray(frame.else_ifs), nullptr)); 
+    ConsumeToken();
+    if (PeekToken().kind == TokenKind::If)
+    {
+        ConsumeToken(); 
+        frame.condition = ParseCondition(); 
+        frame.kind = StatementFrame::Kind::ElseIfBranch; 
+    } else frame.kind = StatementFrame::Kind::ElseBranch; 
+    return nullptr; 
+}
+
+Statement::Ref RDParser::PopStatement(std::vector<StatementFrame>& frames, Statement::Ref statement)
+{
+    frames.pop_back(); 
+    LeaveNesting(); 
+    return statement; 
 }
 
-Statement::Ref RDParser::ParseForStatement()
+void RDParser::ParseForHeader(StatementFrame& frame)
 {
-    keyword(TokenKind::For); 
     lparen();
-    auto token = PeekToken();
-    if (token.kind == TokenKind::Int)
+    if (PeekToken().kind == TokenKind::Int)
     {
         ConsumeToken();
-        auto declaration = ParseDeclaration(); 
-        auto condition = ParseNullExpression(); 
-        if (condition->type() == SyntaxType::Null) condition = CreateRef<IntConstant>(1);
-        semicolon();
-        token = PeekToken();
-        Expression::Ref post_expression;
-        if (token.kind == TokenKind::RightParenthesis)
-        {
-            ConsumeToken(); 
-            post_expression = CreateRef<NullExpression>();
-        } else {
-            post_expression = ParseExpression(); 
-            rparen();
-        }
-        return CreateRef<ForDeclStatement>(declaration, condition, post_expression, ParseStatement()); 
+        frame.kind = StatementFrame::Kind::ForDeclBody; 
+        frame.declaration = ParseDeclaration(); 
     } else {
-        auto expression = ParseNullExpression(); 
+        frame.expression = ParseNullExpression(); 
         semicolon();
-        auto condition = ParseNullExpression(); 
-        if (condition->type() == SyntaxType::Null) condition = CreateRef<IntConstant>(1);
-        semicolon();
-        token = PeekToken();
-        Expression::Ref post_expression;
-        if (token.kind == TokenKind::RightParenthesis)
-        {
-            ConsumeToken(); 
-            post_expression = CreateRef<NullExpression>();
-        } else {
-            post_expression = ParseExpression(); 
-            rparen();
-        }
-        return CreateRef<ForStatement>(expression, condition, post_expression, ParseStatement()); 
+    }
+    frame.condition = ParseNullExpression(); 
+    if (frame.condition->type() == SyntaxType::Null) frame.condition = CreateNode<IntConstant>(1);
+    semicolon();
+    if (PeekToken().kind == TokenKind::RightParenthesis)
+    {
+        ConsumeToken(); 
+        frame.post_expression = CreateNode<NullExpression>();
+    } else {
+        frame.post_expression = ParseExpression(); 
+        rparen();
     }
 }
 
-WhileStatement::Ref RDParser::ParseWhileStatement()
+// ( Expression )
+Expression::Ref RDParser::ParseCondition()
 {
-    keyword(TokenKind::While);
     lparen();
     auto condition = ParseExpression(); 
     rparen();
-    auto body = ParseStatement(); 
-    return CreateRef<WhileStatement>(condition, body);
+    return condition; 
 }
 
 BreakStatement::Ref RDParser::ParseBreakStatement()
 {
     keyword(TokenKind::Break);
     semicolon();
-    return CreateRef<BreakStatement>(); 
+    return CreateNode<BreakStatement>(); 
 }
 
 ContinueStatement::Ref RDParser::ParseContinueStatement()
 {
     keyword(TokenKind::Continue);
     semicolon();
-    return CreateRef<ContinueStatement>(); 
+    return CreateNode<ContinueStatement>(); 
 }
 
 ReturnStatement::Ref RDParser::ParseReturnStatement()
 {
     keyword(TokenKind::Return);
-    auto return_statement = CreateRef<ReturnStatement>(ParseExpression());
+    auto return_statement = CreateNode<ReturnStatement>(ParseExpression());
     semicolon(); 
     return return_statement;
 }
 
 Expression::Ref RDParser::ParseNullExpression()
 {
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::Semicolon)
-        return CreateRef<NullExpression>(); 
+    if (PeekToken().kind == TokenKind::Semicolon)
+        return CreateNode<NullExpression>(); 
     else return ParseExpression(); 
 }
 
 Expression::Ref RDParser::ParseExpression()
 {
-    auto expr = ParseAssignmentExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::Comma)
-    {
-        ConsumeToken(); 
-        auto nextExpr = ParseAssignmentExpression(); 
-        expr = CreateRef<BinaryOp>(BinaryOpType::Comma, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
+    return ParseExpression(ExpressionLevel::Expression); 
 }
 
 Expression::Ref RDParser::ParseAssignmentExpression()
 {
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::Identifier)
+    return ParseExpression(ExpressionLevel::Assignment); 
+}
+
+Expression::Ref RDParser::ParseExpression(ExpressionLevel level)
+{
+    // Every grammar level is a frame on an explicit stack rather than a native 
+    // call, so deeply nested expressions cannot overflow the native stack. 
+    // The parser descends from level to the next primary expression, pushing a 
+    // frame per level, then folds the operand into the frames on its way back 
+    // up until one of them needs another operand. 
+    //
+    // Expression: Assignment (, Assignment)*
+    // Assignment: Identifier (= | op=) Expression | Ternary
+    // Ternary:    Binary(1) [? Expression : Ternary]
+    // Binary(p):  Unary (op Binary(precedence(op) + 1))*, precedence(op) >= p
+    // Unary:      unary-op Unary | ++Identifier | --Identifier | ( Expression ) | operand
+    auto& frames = m_ExpressionFrames; 
+    // a parse error may have left frames behind
+    frames.clear(); 
+    uint8_t min_precedence = 1; 
+    while (true)
     {
-        ConsumeToken(); 
-        auto lvalue = token.value; 
-        token = PeekToken(); 
-        switch (token.kind)
+        Expression::Ref expr = nullptr; 
+        while (expr == nullptr)
         {
-            case TokenKind::Equal:
-                ConsumeToken(); 
-                return CreateRef<Assignment>(lvalue, ParseExpression());
-            case TokenKind::Semicolon:
-                RevertToken(); 
-                return ParseTernaryExpression();
-            default:
-                if (TOKEN_TO_ASSIGNMENT_OP_TYPE.find(token.kind) != TOKEN_TO_ASSIGNMENT_OP_TYPE.end())
+            switch (level)
+            {
+                case ExpressionLevel::Expression:
+                    frames.emplace_back(ExpressionFrame::Kind::Comma); 
+                    level = ExpressionLevel::Assignment; 
+                    break; 
+                case ExpressionLevel::Assignment:
                 {
+                    // an identifier followed by an assignment operator starts an assignment, 
+                    // anything else is left for the ternary expression to parse
+                    level = ExpressionLevel::Ternary; 
+                    const auto& token = PeekToken(); 
+                    if (token.kind != TokenKind::Identifier)
+                        break; 
+                    auto kind = PeekToken(1).kind; 
+                    auto assignment = TOKEN_TO_ASSIGNMENT_OP_TYPE[static_cast<size_t>(kind)]; 
+                    if (kind != TokenKind::Equal && !assignment.found)
+                        break; 
+                    EnterNesting(token); 
+                    auto& frame = frames.emplace_back(kind == TokenKind::Equal ? ExpressionFrame::Kind::Assignment : 
+                        ExpressionFrame::Kind::AssignmentOp); 
+                    frame.lvalue = token.id; 
+                    if (kind != TokenKind::Equal) frame.assignment_type = assignment.type; 
                     ConsumeToken(); 
-                    return CreateRef<AssignmentOp>(TOKEN_TO_ASSIGNMENT_OP_TYPE[token.kind], lvalue, ParseExpression()); 
+                    ConsumeToken(); 
+                    level = ExpressionLevel::Expression; 
+                    break; 
+                }
+                case ExpressionLevel::Ternary:
+                    frames.emplace_back(ExpressionFrame::Kind::Ternary); 
+                    level = ExpressionLevel::Binary; 
+                    min_precedence = 1; 
+                    break; 
+                case ExpressionLevel::Binary:
+                    frames.emplace_back(ExpressionFrame::Kind::Binary).min_precedence = min_precedence; 
+                    level = ExpressionLevel::Unary; 
+                    break; 
+                case ExpressionLevel::Unary:
+                {
+                    auto kind = PeekToken().kind;
+                    auto unary = TOKEN_TO_UNARY_TYPE[static_cast<size_t>(kind)]; 
+                    if (unary.found)
+                    {
+                        auto type = unary.type;
+                        if (kind == TokenKind::PlusPlus || kind == TokenKind::MinusMinus)
+                        {
+                            ConsumeToken();
+                            const auto& token = NextToken(); 
+                            if (token.kind != TokenKind::Identifier) 
+                                ExceptParse("error: lvalue required for operator '" + std::string(token_kind_name(token.kind)) + "'", token);
+                            expr = CreateNode<UnaryOp>(type, CreateNode<VariableRef>(token.id)); 
+                            break; 
+                        }
+                        EnterNesting(NextToken()); 
+                        frames.emplace_back(ExpressionFrame::Kind::Unary).unary_type = type; 
+                        break; 
+                    }
+                    const auto& token = NextToken();
+                    if (token.kind == TokenKind::LeftParenthesis)
+                    {
+                        EnterNesting(token); 
+                        frames.emplace_back(ExpressionFrame::Kind::Parenthesis); 
+                        level = ExpressionLevel::Expression; 
+                    } else expr = ParseOperand(token); 
+                    break; 
                 }
-                RevertToken();
-                return ParseTernaryExpression(); 
+            }
         }
-    } else return ParseTernaryExpression(); 
-}
-
-Expression::Ref RDParser::ParseTernaryExpression()
-{
-    auto expr = ParseLogicalOrExpression();
-    auto token = PeekToken();
-    if (token.kind == TokenKind::QuestionMark)
-    {
-        ConsumeToken();
-        auto lvalue = ParseExpression();
-        colon();
-        auto rvalue = ParseTernaryExpression();
-        return CreateRef<TernaryOp>(expr, lvalue, rvalue);
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseLogicalOrExpression()
-{
-    auto expr = ParseLogicalAndExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::DoublePipe)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseLogicalAndExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseLogicalAndExpression()
-{
-    auto expr = ParseBitwiseOrExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::DoubleAmpersand)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseBitwiseOrExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseBitwiseOrExpression()
-{
-    auto expr = ParseBitwiseXORExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::Pipe)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseBitwiseXORExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseBitwiseXORExpression()
-{
-    auto expr = ParseBitwiseAndExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::Caret)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseBitwiseAndExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseBitwiseAndExpression()
-{
-    auto expr = ParseEqualityExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::Ampersand)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseEqualityExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseEqualityExpression()
-{
-    auto expr = ParseRelationalExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::DoubleEquals || token.kind == TokenKind::NotEqual)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseRelationalExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
 
-Expression::Ref RDParser::ParseRelationalExpression()
-{
-    auto expr = ParseShiftExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::LessThan || token.kind == TokenKind::LessThanOrEqual ||
-            token.kind == TokenKind::GreaterThan || token.kind == TokenKind::GreaterThanOrEqual)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseShiftExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseShiftExpression()
-{
-    auto expr = ParseAdditiveExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::LeftShift || token.kind == TokenKind::RightShift)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind];
-        auto nextExpr = ParseAdditiveExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken();
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseAdditiveExpression()
-{
-    auto term = ParseTerm(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
-    while (token.kind == TokenKind::Plus || token.kind == TokenKind::Minus)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind]; 
-        auto nextTerm = ParseTerm(); 
-        term = CreateRef<BinaryOp>(type, term, nextTerm); 
-        token = PeekToken(); 
-    }
-    return term; 
-}
-
-Expression::Ref RDParser::ParseTerm()
-{
-    auto expr = ParseUnaryExpression(); 
-    auto token = PeekToken(); 
-    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete term", token); 
-    while (token.kind == TokenKind::Asterisk || token.kind == TokenKind::Slash || token.kind == TokenKind::Percent)
-    {
-        ConsumeToken(); 
-        auto type = TOKEN_TO_BINARY_TYPE[token.kind]; 
-        auto nextExpr = ParseUnaryExpression(); 
-        expr = CreateRef<BinaryOp>(type, expr, nextExpr); 
-        token = PeekToken(); 
-    }
-    return expr; 
-}
-
-Expression::Ref RDParser::ParseUnaryExpression()
-{
-    auto token = PeekToken();
-    if (TOKEN_TO_UNARY_TYPE.find(token.kind) != TOKEN_TO_UNARY_TYPE.end())
-    {
-        auto type = TOKEN_TO_UNARY_TYPE[token.kind];
-        ConsumeToken();
-        switch (token.kind)
+        // fold the operand into the waiting frames
+        bool descend = false; 
+        while (!descend && !frames.empty())
         {
-            case TokenKind::PlusPlus:
-            case TokenKind::MinusMinus:
+            auto& frame = frames.back(); 
+            switch (frame.kind)
             {
-                token = NextToken(); 
-                if (token.kind != TokenKind::Identifier) 
-                    ExceptParse("error: lvalue required for operator '" + TOKEN_KIND_NAMES[token.kind] + "'", token);
-                return CreateRef<UnaryOp>(type, CreateRef<VariableRef>(token.value)); 
+                case ExpressionFrame::Kind::Comma:
+                {
+                    if (frame.lhs != nullptr)
+                    {
+                        expr = CreateNode<BinaryOp>(BinaryOpType::Comma, frame.lhs, expr); 
+                        frame.lhs = nullptr; 
+                        LeaveNesting(); 
+                    }
+                    const auto& token = PeekToken(); 
+                    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
+                    if (token.kind != TokenKind::Comma)
+                    {
+                        frames.pop_back(); 
+                        break; 
+                    }
+                    EnterNesting(token); 
+                    ConsumeToken(); 
+                    frame.lhs = expr; 
+                    level = ExpressionLevel::Assignment; 
+                    descend = true; 
+                    break; 
+                }
+                case ExpressionFrame::Kind::Assignment:
+                    expr = CreateNode<Assignment>(frame.lvalue, expr); 
+                    frames.pop_back(); 
+                    LeaveNesting(); 
+                    break; 
+                case ExpressionFrame::Kind::AssignmentOp:
+                    expr = CreateNode<AssignmentOp>(frame.assignment_type, frame.lvalue, expr); 
+                    frames.pop_back(); 
+                    LeaveNesting(); 
+                    break; 
+                case ExpressionFrame::Kind::Ternary:
+                    if (frame.state == 0)
+                    {
+                        const auto& token = PeekToken(); 
+                        if (token.kind != TokenKind::QuestionMark)
+                        {
+                            frames.pop_back(); 
+                            break; 
+                        }
+                        EnterNesting(token); 
+                        ConsumeToken(); 
+                        frame.lhs = expr; 
+                        frame.state = 1; 
+                        level = ExpressionLevel::Expression; 
+                    } else if (frame.state == 1) {
+                        colon(); 
+                        frame.middle = expr; 
+                        frame.state = 2; 
+                        level = ExpressionLevel::Ternary; 
+                    } else {
+                        expr = CreateNode<TernaryOp>(frame.lhs, frame.middle, expr); 
+                        frames.pop_back(); 
+                        LeaveNesting(); 
+                        break; 
+                    }
+                    descend = true; 
+                    break; 
+                case ExpressionFrame::Kind::Binary:
+                {
+                    // precedence climbing: operators binding at least as tight as
+                    // min_precedence are folded in left to right, tighter ones on the
+                    // right hand side are collected by the frame pushed for it
+                    if (frame.lhs != nullptr)
+                    {
+                        expr = CreateNode<BinaryOp>(frame.binary_type, frame.lhs, expr); 
+                        frame.lhs = nullptr; 
+                        LeaveNesting(); 
+                    }
+                    const auto& token = PeekToken(); 
+                    if (token.kind == TokenKind::None) ExceptParse("error: Incomplete expression", token); 
+                    // non-operators have precedence 0 and end the loop
+                    auto op = TOKEN_TO_BINARY_OPERATOR[static_cast<size_t>(token.kind)]; 
+                    if (op.precedence < frame.min_precedence)
+                    {
+                        frames.pop_back(); 
+                        break; 
+                    }
+                    EnterNesting(token); 
+                    ConsumeToken(); 
+                    frame.lhs = expr; 
+                    frame.binary_type = op.type; 
+                    level = ExpressionLevel::Binary; 
+                    min_precedence = op.precedence + 1; 
+                    descend = true; 
+                    break; 
+                }
+                case ExpressionFrame::Kind::Unary:
+                    expr = CreateNode<UnaryOp>(frame.unary_type, expr); 
+                    frames.pop_back(); 
+                    LeaveNesting(); 
+                    break; 
+                case ExpressionFrame::Kind::Parenthesis:
+                    rparen(); 
+                    frames.pop_back(); 
+                    LeaveNesting(); 
+                    break; 
             }
         }
-        return CreateRef<UnaryOp>(type, ParseUnaryExpression()); 
-    } else return ParseFactor(); 
+        if (!descend) return expr; 
+    }
 }
 
-Expression::Ref RDParser::ParseFactor()
+// IntConstant | Identifier [++ | --]
+Expression::Ref RDParser::ParseOperand(const Token& token)
 {
-    auto token = NextToken();
-    if (token.kind == TokenKind::LeftParenthesis)
-    {
-        auto expr = ParseExpression(); 
-        rparen();
-        return expr; 
-    } else if (token.kind == TokenKind::IntConstant || token.kind == TokenKind::HexConstant)
-        return CreateRef<IntConstant>(parse_c_int(token.value)); 
+    if (token.kind == TokenKind::IntConstant || token.kind == TokenKind::HexConstant)
+        return CreateNode<IntConstant>(static_cast<int>(token.constant)); 
     else if (token.kind == TokenKind::Identifier) 
     {
-        auto value = token.value;
-        token = PeekToken();
+        auto value = token.id;
+        auto kind = PeekToken().kind;
         // parse postfix ops
-        switch (token.kind)
+        switch (kind)
         {
             case TokenKind::PlusPlus:
             case TokenKind::MinusMinus:
                 ConsumeToken(); 
-                auto op = token.kind == TokenKind::PlusPlus ? UnaryOpType::PostfixIncrement :
+                auto op = kind == TokenKind::PlusPlus ? UnaryOpType::PostfixIncrement :
                     UnaryOpType::PostfixDecrement;
-                return CreateRef<UnaryOp>(op, CreateRef<VariableRef>(value)); 
+                return CreateNode<UnaryOp>(op, CreateNode<VariableRef>(value)); 
         }
-        return CreateRef<VariableRef>(value);
+        return CreateNode<VariableRef>(value);
     }
-    else ExceptParse("error: Unexpected token '" + TOKEN_KIND_NAMES[token.kind] + "'", token); 
+    else ExceptParse("error: Unexpected token '" + std::string(token_kind_name(token.kind)) + "'", token); 
     return nullptr; 
 }
\ No newline at end of file
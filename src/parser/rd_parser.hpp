@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
-#include "int_conv.hpp"
 #include "maps.hpp"
 #include "parser.hpp"
 #include "print.hpp"
@@ -20,20 +22,102 @@ public:
     void LogTree(std::ostream& out, const AbstractSyntax::Ref root) const override;
 
 private:
+    // a statement waiting for the statement nested in it
+    struct StatementFrame
+    {
+        enum class Kind : uint8_t
+        {
+            Block,
+            IfBranch,
+            ElseIfBranch,
+            ElseBranch,
+            WhileBody,
+            DoWhileBody,
+            ForBody,
+            ForDeclBody
+        };
+
+        Kind kind; 
+        Expression::Ref condition = nullptr; 
+        Expression::Ref expression = nullptr; 
+        Expression::Ref post_expression = nullptr; 
+        Declaration::Ref declaration = nullptr; 
+        // the branches of an if statement parsed so far
+        Conditional conditional{ nullptr, nullptr }; 
+        std::vector<Conditional> else_ifs; 
+        // the items of a compound block parsed so far
+        std::vector<Statement::Ref> statements; 
+
+        StatementFrame(Kind kind) : kind(kind)
+        {
+        }
+    };
+
+    // the grammar levels an expression can be parsed from, loosest first
+    enum class ExpressionLevel : uint8_t
+    {
+        Expression,
+        Assignment,
+        Ternary,
+        Binary,
+        Unary
+    };
+
+    // an expression construct waiting for its next operand
+    struct ExpressionFrame
+    {
+        enum class Kind : uint8_t
+        {
+            Comma,
+            Assignment,
+            AssignmentOp,
+            Ternary,
+            Binary,
+            Unary,
+            Parenthesis
+        };
+
+        Kind kind; 
+        // ternary: 0 parses the condition, 1 the true and 2 the false branch
+        uint8_t state = 0; 
+        // binary: operators binding looser than this end the operand
+        uint8_t min_precedence = 0; 
+        BinaryOpType binary_type = BinaryOpType::Comma; 
+        UnaryOpType unary_type = UnaryOpType::Negation; 
+        AssignmentOpType assignment_type = AssignmentOpType::Add; 
+        StringId lvalue = 0; 
+        // the operands parsed so far
+        Expression::Ref lhs = nullptr; 
+        Expression::Ref middle = nullptr; 
+
+        ExpressionFrame(Kind kind) : kind(kind)
+        {
+        }
+    };
+
+    // frame stack of the expression being parsed, kept across calls so that
+    // parsing an expression does not allocate once the stack has grown
+    std::vector<ExpressionFrame> m_ExpressionFrames; 
+
     Program::Ref ParseProgram();
     Function::Ref ParseFunction();
-    Statement::Ref ParseBlockItem();
     
     Variable ParseVariable();
     Declaration::Ref ParseDeclaration();
 
     Statement::Ref ParseStatement();
     CompoundBlock::Ref ParseCompoundBlock();
-    Conditional ParseIfCondition();
-    IfStatement::Ref ParseIfStatement();
-    DoWhileStatement::Ref ParseDoWhileStatement();
-    Statement::Ref ParseForStatement();
-    WhileStatement::Ref ParseWhileStatement();
+    // parses a statement up to the statement nested in it and pushes a frame
+    // for it; returns nullptr if a nested statement has to be parsed next
+    Statement::Ref ParseStatementHead(std::vector<StatementFrame>& frames);
+    // hands a finished statement to the innermost frame; returns the frame's
+    // statement once it is complete, nullptr if it needs another nested one
+    Statement::Ref CompleteStatement(std::vector<StatementFrame>& frames, Statement::Ref statement);
+    Statement::Ref ContinueBlock(std::vector<StatementFrame>& frames);
+    Statement::Ref ContinueIf(std::vector<StatementFrame>& frames);
+    Statement::Ref PopStatement(std::vector<StatementFrame>& frames, Statement::Ref statement);
+    void ParseForHeader(StatementFrame& frame);
+    Expression::Ref ParseCondition();
     BreakStatement::Ref ParseBreakStatement(); 
     ContinueStatement::Ref ParseContinueStatement();
     ReturnStatement::Ref ParseReturnStatement(); 
@@ -41,17 +125,6 @@ private:
     Expression::Ref ParseNullExpression();
     Expression::Ref ParseExpression();
     Expression::Ref ParseAssignmentExpression();
-    Expression::Ref ParseTernaryExpression();
-    Expression::Ref ParseLogicalOrExpression();
-    Expression::Ref ParseLogicalAndExpression();
-    Expression::Ref ParseBitwiseOrExpression();
-    Expression::Ref ParseBitwiseXORExpression();
-    Expression::Ref ParseBitwiseAndExpression();
-    Expression::Ref ParseEqualityExpression();
-    Expression::Ref ParseRelationalExpression();
-    Expression::Ref ParseShiftExpression();
-    Expression::Ref ParseAdditiveExpression();
-    Expression::Ref ParseTerm();
-    Expression::Ref ParseUnaryExpression();
-    Expression::Ref ParseFactor();
+    Expression::Ref ParseExpression(ExpressionLevel level);
+    Expression::Ref ParseOperand(const Token& token);
 };
\ No newline at end of file
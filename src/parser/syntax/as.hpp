@@ -1,10 +1,13 @@
 #pragma once
 
-#include <memory>
+#include <cassert>
+#include <cstdint>
 
+#include "utility/arena.hpp"
+#include "utility/interner.hpp"
 #include "utility/ref.hpp"
 
-enum class SyntaxType : int
+enum class SyntaxType : uint8_t
 {
     Program,
     Function,
@@ -38,19 +41,20 @@ public:
     AbstractSyntax(SyntaxType type) : _type(type) 
     {
     }
-    
-    virtual ~AbstractSyntax() = default;
 
     SyntaxType type()
     {
         return _type; 
     }
 
-    typedef std::shared_ptr<AbstractSyntax> Ref; 
+    // nodes live in the parser's arena, references to them do not own them
+    typedef AbstractSyntax* Ref; 
+    // checked downcast keyed on the node's tag; T must declare its TYPE
     template<typename T>
-    static std::shared_ptr<T> RefCast(Ref ref)
+    static T* RefCast(Ref ref)
     {
-        return std::dynamic_pointer_cast<T>(ref); 
+        assert(ref == nullptr || ref->type() == T::TYPE); 
+        return static_cast<T*>(ref); 
     }
 private:
     SyntaxType _type; 
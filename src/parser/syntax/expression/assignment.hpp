@@ -4,12 +4,13 @@
 
 struct Assignment : public Expression
 {
-    std::string lvalue; 
+    StringId lvalue; 
     Expression::Ref rvalue; 
 
-    Assignment(const std::string& lvalue, Expression::Ref rvalue) : Expression(SyntaxType::Assignment), lvalue(lvalue), rvalue(rvalue)
+    Assignment(StringId lvalue, Expression::Ref rvalue) : Expression(SyntaxType::Assignment), lvalue(lvalue), rvalue(rvalue)
     {
     }
 
-    typedef std::shared_ptr<Assignment> Ref;
+    typedef Assignment* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::Assignment;
 };
\ No newline at end of file
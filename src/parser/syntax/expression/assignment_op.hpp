@@ -2,7 +2,7 @@
 
 #include "expression.hpp"
 
-enum class AssignmentOpType : int
+enum class AssignmentOpType : uint8_t
 {
     Add,
     Minus,
@@ -18,11 +18,14 @@ enum class AssignmentOpType : int
 
 class AssignmentOp : public Expression
 {
+private:
+    // declared first so it packs next to the node tag
+    AssignmentOpType opType; 
 public:
-    std::string lvalue; 
+    StringId lvalue; 
     Expression::Ref rvalue; 
 
-    AssignmentOp(AssignmentOpType opType, const std::string& lvalue, Expression::Ref rvalue) : 
+    AssignmentOp(AssignmentOpType opType, StringId lvalue, Expression::Ref rvalue) : 
         Expression(SyntaxType::AssignmentOp), opType(opType), lvalue(lvalue), rvalue(rvalue)
     {
     }
@@ -32,7 +35,6 @@ public:
         return opType; 
     }
 
-    typedef std::shared_ptr<AssignmentOp> Ref;
-private:
-    AssignmentOpType opType; 
+    typedef AssignmentOp* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::AssignmentOp;
 };
\ No newline at end of file
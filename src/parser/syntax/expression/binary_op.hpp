@@ -2,7 +2,7 @@
 
 #include "expression.hpp"
 
-enum class BinaryOpType
+enum class BinaryOpType : uint8_t
 {
     Addition,
     Subtraction,
@@ -27,6 +27,9 @@ enum class BinaryOpType
 
 class BinaryOp : public Expression
 {
+private:
+    // declared first so it packs next to the node tag
+    BinaryOpType opType; 
 public:
     Expression::Ref lvalue; 
     Expression::Ref rvalue; 
@@ -40,7 +43,6 @@ public:
         return opType; 
     }
 
-    typedef std::shared_ptr<BinaryOp> Ref;
-private:
-    BinaryOpType opType; 
+    typedef BinaryOp* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::BinaryOp;
 };
\ No newline at end of file
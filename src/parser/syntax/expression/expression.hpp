@@ -8,7 +8,5 @@ struct Expression : public AbstractSyntax
     {
     }
 
-    virtual ~Expression() = default; 
-
-    typedef std::shared_ptr<Expression> Ref;
+    typedef Expression* Ref;
 };
@@ -10,5 +10,6 @@ struct IntConstant : public Expression
     {
     }
 
-    typedef std::shared_ptr<IntConstant> Ref;
+    typedef IntConstant* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::IntConstant;
 };
\ No newline at end of file
@@ -7,4 +7,7 @@ struct NullExpression : public Expression
     NullExpression() : Expression(SyntaxType::Null)
     {
     }
+
+    typedef NullExpression* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::Null;
 };
\ No newline at end of file
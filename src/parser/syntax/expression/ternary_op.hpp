@@ -11,5 +11,6 @@ struct TernaryOp : public Expression
     {
     }
 
-    typedef std::shared_ptr<TernaryOp> Ref; 
+    typedef TernaryOp* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::TernaryOp;
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "expression.hpp"
 
-enum class UnaryOpType : int
+enum class UnaryOpType : uint8_t
 {
     Negation,
     Complement,
@@ -15,6 +15,9 @@ enum class UnaryOpType : int
 
 class UnaryOp : public Expression
 {
+private:
+    // declared first so it packs next to the node tag
+    UnaryOpType opType; 
 public:
     Expression::Ref expr; 
 
@@ -27,7 +30,6 @@ public:
         return opType; 
     }
 
-    typedef std::shared_ptr<UnaryOp> Ref;
-private:
-    UnaryOpType opType; 
+    typedef UnaryOp* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::UnaryOp;
 };
\ No newline at end of file
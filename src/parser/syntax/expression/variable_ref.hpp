@@ -4,11 +4,12 @@
 
 struct VariableRef : public Expression
 {
-    std::string name; 
+    StringId name; 
 
-    VariableRef(const std::string& name) : Expression(SyntaxType::VariableRef), name(name)
+    VariableRef(StringId name) : Expression(SyntaxType::VariableRef), name(name)
     {
     }
 
-    typedef std::shared_ptr<VariableRef> Ref;
+    typedef VariableRef* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::VariableRef;
 };
\ No newline at end of file
@@ -10,5 +10,6 @@ struct Program : public AbstractSyntax
     {
     }
 
-    typedef std::shared_ptr<Program> Ref;
+    typedef Program* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::Program;
 };
\ No newline at end of file
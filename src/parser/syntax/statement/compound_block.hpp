@@ -1,22 +1,15 @@
 #pragma once
 
-#include <vector>
-
 #include "statement.hpp"
 
 struct CompoundBlock : public Statement
 {
-    std::vector<Statement::Ref> statements; 
-    std::string start_label, end_label;
+    ArenaArray<Statement::Ref> statements; 
 
-    CompoundBlock() : Statement(SyntaxType::CompoundBlock)
+    CompoundBlock(ArenaArray<Statement::Ref> statements) : Statement(SyntaxType::CompoundBlock), statements(statements)
     {
     } 
 
-    CompoundBlock(Statement::Ref statement) : Statement(SyntaxType::CompoundBlock)
-    {
-        statements.emplace_back(statement); 
-    }
-
-    typedef std::shared_ptr<CompoundBlock> Ref; 
+    typedef CompoundBlock* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::CompoundBlock;
 };
\ No newline at end of file
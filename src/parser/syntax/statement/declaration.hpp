@@ -4,27 +4,23 @@
 
 struct Variable
 {
-    std::string name; 
+    StringId name; 
     Expression::Ref expression; 
 
-    Variable(const std::string& name, Expression::Ref expression) : name(name), expression(expression)
+    Variable(StringId name, Expression::Ref expression) : name(name), expression(expression)
     {
     }
 };
 
 struct Declaration : public Statement
 {
-    size_t type_size = 0; 
-    std::vector<Variable> variables; 
+    uint32_t type_size = 0; 
+    ArenaArray<Variable> variables; 
 
-    Declaration(size_t type_size) : Statement(SyntaxType::Declaration), type_size(type_size)
+    Declaration(uint32_t type_size, ArenaArray<Variable> variables) : Statement(SyntaxType::Declaration), type_size(type_size), variables(variables)
     {
     }
 
-    Declaration(size_t type_size, Variable var) : Statement(SyntaxType::Declaration), type_size(type_size)
-    {
-        variables.emplace_back(var); 
-    }
-
-    typedef std::shared_ptr<Declaration> Ref;
+    typedef Declaration* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::Declaration;
 };
\ No newline at end of file
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <vector>
-
 #include "compound_block.hpp"
 
 struct Conditional
@@ -17,12 +15,14 @@ struct Conditional
 struct IfStatement : public Statement
 {
     Conditional if_conditional; 
-    std::vector<Conditional> else_ifs; 
+    ArenaArray<Conditional> else_ifs; 
     Statement::Ref else_statement = nullptr;
 
-    IfStatement(const Conditional& conditional) : Statement(SyntaxType::IfStatement), if_conditional(conditional)
+    IfStatement(const Conditional& conditional, ArenaArray<Conditional> else_ifs, Statement::Ref else_statement) : 
+        Statement(SyntaxType::IfStatement), if_conditional(conditional), else_ifs(else_ifs), else_statement(else_statement)
     {
     }
 
-    typedef std::shared_ptr<IfStatement> Ref;  
+    typedef IfStatement* Ref;  
+    static constexpr SyntaxType TYPE = SyntaxType::IfStatement;
 };
\ No newline at end of file
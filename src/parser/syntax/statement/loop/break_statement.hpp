@@ -8,5 +8,6 @@ struct BreakStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<BreakStatement> Ref; 
+    typedef BreakStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::Break;
 };
\ No newline at end of file
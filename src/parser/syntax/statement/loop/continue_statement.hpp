@@ -8,5 +8,6 @@ struct ContinueStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<ContinueStatement> Ref; 
+    typedef ContinueStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::Continue;
 };
\ No newline at end of file
@@ -11,5 +11,6 @@ struct DoWhileStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<DoWhileStatement> Ref; 
+    typedef DoWhileStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::DoWhile;
 };
\ No newline at end of file
@@ -16,5 +16,6 @@ struct ForDeclStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<ForDeclStatement> Ref; 
+    typedef ForDeclStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::ForDecl;
 };
\ No newline at end of file
@@ -15,5 +15,6 @@ struct ForStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<ForStatement> Ref; 
+    typedef ForStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::For;
 };
\ No newline at end of file
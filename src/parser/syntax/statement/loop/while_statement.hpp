@@ -12,5 +12,6 @@ struct WhileStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<WhileStatement> Ref; 
+    typedef WhileStatement* Ref; 
+    static constexpr SyntaxType TYPE = SyntaxType::While;
 };
\ No newline at end of file
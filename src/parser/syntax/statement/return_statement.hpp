@@ -10,5 +10,6 @@ struct ReturnStatement : public Statement
     {
     }
 
-    typedef std::shared_ptr<ReturnStatement> Ref;
+    typedef ReturnStatement* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::Return;
 };
\ No newline at end of file
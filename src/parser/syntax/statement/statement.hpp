@@ -11,7 +11,5 @@ struct Statement : public AbstractSyntax
     {
     }
 
-    virtual ~Statement() = default; 
-
-    typedef std::shared_ptr<Statement> Ref;
+    typedef Statement* Ref;
 };
\ No newline at end of file
@@ -10,5 +10,6 @@ struct StatementExpression : public Statement
     {
     }
 
-    typedef std::shared_ptr<StatementExpression> Ref;
+    typedef StatementExpression* Ref;
+    static constexpr SyntaxType TYPE = SyntaxType::StatementExpression;
 };
\ No newline at end of file
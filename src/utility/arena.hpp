@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed-size run of objects stored contiguously in an arena, a non-owning
+// view that is smaller than a std::vector and never allocates by itself
+template<typename T>
+class ArenaArray
+{
+public:
+    ArenaArray() = default; 
+    ArenaArray(T* data, uint32_t size) : m_Data(data), m_Size(size)
+    {
+    }
+
+    T* begin() const { return m_Data; }
+    T* end() const { return m_Data + m_Size; }
+    uint32_t size() const { return m_Size; }
+    bool empty() const { return m_Size == 0; }
+    T& operator[](size_t index) const { return m_Data[index]; }
+
+private:
+    T* m_Data = nullptr; 
+    uint32_t m_Size = 0; 
+};
+
+// Bump allocator for objects that all die together, such as the nodes of one
+// syntax tree. Objects are constructed in place in large blocks and are never
+// freed one by one; the whole arena is released at once and the destructors
+// of objects that need one run in reverse order of creation.
+class Arena
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64 << 10; 
+
+    Arena() = default; 
+    Arena(const Arena&) = delete; 
+    Arena& operator=(const Arena&) = delete; 
+
+    ~Arena()
+    {
+        Clear(); 
+    }
+
+    template<typename T, typename ... Args>
+    T* Create(Args&& ... args)
+    {
+        T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); 
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            m_Destructors.push_back({ object, [](void* object) { static_cast<T*>(object)->~T(); } }); 
+        return object; 
+    }
+
+    // copies items into one contiguous run owned by the arena
+    template<typename T>
+    ArenaArray<T> CreateArray(const std::vector<T>& items)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena arrays are never destroyed"); 
+        if (items.empty()) return ArenaArray<T>(); 
+        T* data = static_cast<T*>(Allocate(sizeof(T) * items.size(), alignof(T))); 
+        std::uninitialized_copy(items.begin(), items.end(), data); 
+        return ArenaArray<T>(data, static_cast<uint32_t>(items.size())); 
+    }
+
+    void* Allocate(size_t size, size_t alignment)
+    {
+        auto aligned = Align(m_Current, alignment); 
+        if (m_Current == nullptr || aligned + size > reinterpret_cast<uintptr_t>(m_End))
+        {
+            size_t block_size = std::max(BLOCK_SIZE, size + alignment); 
+            m_Blocks.emplace_back(new std::byte[block_size]); 
+            m_Current = m_Blocks.back().get(); 
+            m_End = m_Current + block_size; 
+            aligned = Align(m_Current, alignment); 
+        }
+        m_Current = reinterpret_cast<std::byte*>(aligned + size); 
+        return reinterpret_cast<void*>(aligned); 
+    }
+
+    // destroys every object and releases all blocks
+    void Clear()
+    {
+        for (auto iter = m_Destructors.rbegin(); iter != m_Destructors.rend(); iter++)
+            iter->destroy(iter->object); 
+        m_Destructors.clear(); 
+        m_Blocks.clear(); 
+        m_Current = m_End = nullptr; 
+    }
+
+    size_t BlockCount() const { return m_Blocks.size(); }
+
+private:
+    struct Destructor
+    {
+        void* object; 
+        void (*destroy)(void*); 
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> m_Blocks; 
+    std::vector<Destructor> m_Destructors; 
+    std::byte* m_Current = nullptr; 
+    std::byte* m_End = nullptr; 
+
+    static uintptr_t Align(std::byte* pointer, size_t alignment)
+    {
+        auto address = reinterpret_cast<uintptr_t>(pointer); 
+        return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1); 
+    }
+};
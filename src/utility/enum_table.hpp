@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+// Tables indexed by an enum are written as lists of { key, value } entries in
+// enumerator order. The key is only there to be checked: a static_assert on
+// is_enum_indexed() fails to compile when an enumerator is added, removed or
+// reordered without updating the table, and lookups index the list directly.
+template <typename Entry, size_t N>
+static constexpr bool is_enum_indexed(const Entry (&entries)[N], size_t enum_count)
+{
+    if (N != enum_count) return false; 
+    for (size_t i = 0; i < N; i++)
+        if (static_cast<size_t>(entries[i].key) != i) return false; 
+    return true; 
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dense handle of an interned string. Handles are issued from 0 upwards, so
+// they can index plain arrays, and two handles from the same interner are
+// equal exactly when their strings are.
+typedef uint32_t StringId; 
+
+// Per-compilation table of identifier spellings. Each distinct string is
+// stored once; everything downstream of the lexer keeps the handle and only
+// goes back to the text to print it.
+class StringInterner
+{
+public:
+    StringInterner() = default; 
+    StringInterner(const StringInterner&) = delete; 
+    StringInterner& operator=(const StringInterner&) = delete; 
+
+    StringId Intern(std::string_view text)
+    {
+        auto iter = m_Ids.find(text); 
+        if (iter != m_Ids.end()) return iter->second; 
+        if (m_Strings.size() > UINT32_MAX)
+            throw std::runtime_error("error: Too many distinct identifiers"); 
+        // deque elements never move, so views into them stay valid
+        std::string_view stored = m_Storage.emplace_back(text); 
+        auto id = static_cast<StringId>(m_Strings.size()); 
+        m_Strings.emplace_back(stored); 
+        m_Ids.emplace(stored, id); 
+        return id; 
+    }
+
+    std::string_view Lookup(StringId id) const { return m_Strings[id]; }
+    size_t size() const { return m_Strings.size(); }
+
+private:
+    std::deque<std::string> m_Storage; 
+    std::vector<std::string_view> m_Strings; 
+    std::unordered_map<std::string_view, StringId> m_Ids; 
+};